@@ -38,16 +38,43 @@ bit_interleaving_coder = [
     ("ArithmeticCoder", "coders/ArithmeticCoder.hpp", []),
 ]
 
+# Coders that write all values as a single block, and therefore require
+# that the stream is not written to otherwise while they are in use.
+split_literal_coder = [
+    ("HuffmanCoder",            "coders/HuffmanCoder.hpp",            []),
+    ("AdaptiveArithmeticCoder", "coders/AdaptiveArithmeticCoder.hpp", []),
+]
+
+split_value_coder = [
+    ("AdaptiveArithmeticCoder", "coders/AdaptiveArithmeticCoder.hpp", []),
+]
+
+byte_coder = [
+    ("StreamVByteCoder", "coders/StreamVByteCoder.hpp", []),
+]
+
+block_coder = byte_coder + [
+    ("AdaptiveArithmeticCoder", "coders/AdaptiveArithmeticCoder.hpp", []),
+    ("SplitCoder",              "coders/SplitCoder.hpp",              [split_literal_coder, split_value_coder, split_value_coder, split_value_coder]),
+]
+
 coder = tmp_lz78u_string_coder + bit_interleaving_coder + [
     ("SLECoder",   "coders/SLECoder.hpp",   []),
-] 
+] + block_coder
 
 non_bit_interleaving_coder = [i for i in coder if i not in bit_interleaving_coder]
 
+# These coders require that literals are encoded in exactly the order
+# in which the literal iterator yields them.
+ordered_literal_coder = [
+    ("RANSCoder", "coders/RANSCoder.hpp", []),
+]
+
 lz78_trie = [
     ("lz78::BinarySortedTrie", "compressors/lz78/BinarySortedTrie.hpp", []),
     ("lz78::BinaryTrie",       "compressors/lz78/BinaryTrie.hpp",       []),
     ("lz78::HashTrie",         "compressors/lz78/HashTrie.hpp",         []),
+    ("lz78::CompactHashTrie",  "compressors/lz78/CompactHashTrie.hpp",  []),
     ("lz78::MyHashTrie",       "compressors/lz78/MyHashTrie.hpp",       []),
     ("lz78::TernaryTrie",      "compressors/lz78/TernaryTrie.hpp",      []),
     ("lz78::CedarTrie",        "compressors/lz78/CedarTrie.hpp",        []),
@@ -61,6 +88,7 @@ lcpc_strat = [
     ("lcpcomp::MaxHeapStrategy",  "compressors/lcpcomp/compress/MaxHeapStrategy.hpp",   []),
     ("lcpcomp::MaxLCPStrategy",   "compressors/lcpcomp/compress/MaxLCPStrategy.hpp",    []),
     ("lcpcomp::ArraysComp", "compressors/lcpcomp/compress/ArraysComp.hpp",  []),
+    ("lcpcomp::ArraysCompParallel", "compressors/lcpcomp/compress/ArraysCompParallel.hpp",  []),
     ("lcpcomp::PLCPPeaksStrategy","compressors/lcpcomp/compress/PLCPPeaksStrategy.hpp", []),
 ]
 
@@ -73,6 +101,7 @@ lcpc_buffer = [
     ("lcpcomp::ScanDec",       "compressors/lcpcomp/decompress/ScanDec.hpp", []),
     ("lcpcomp::DecodeForwardQueueListBuffer", "compressors/lcpcomp/decompress/DecodeQueueListBuffer.hpp",  []),
     ("lcpcomp::CompactDec",           "compressors/lcpcomp/decompress/CompactDec.hpp",     []),
+    ("lcpcomp::ParallelDec",          "compressors/lcpcomp/decompress/ParallelDec.hpp",    []),
     ("lcpcomp::MyMapBuffer",                  "compressors/lcpcomp/decompress/MyMapBuffer.hpp",            []),
     ("lcpcomp::MultimapBuffer",               "compressors/lcpcomp/decompress/MultiMapBuffer.hpp",         []),
 ]
@@ -82,25 +111,74 @@ lcpc_coder = [
     ("SLECoder", "coders/SLECoder.hpp", []),
 ]
 
+# Coders that are only registered for lcpcomp with its default strategy,
+# decoder and text data structures, to keep the amount of registered
+# combinations small.
+lcpc_block_coder = block_coder + ordered_literal_coder
+
 lz78u_strategy = [
     ("lz78u::StreamingStrategy", "compressors/lz78u/StreamingStrategy.hpp", [context_free_coder]),
-    ("lz78u::BufferingStrategy", "compressors/lz78u/BufferingStrategy.hpp", [tmp_lz78u_string_coder]),
+    ("lz78u::BufferingStrategy", "compressors/lz78u/BufferingStrategy.hpp", [tmp_lz78u_string_coder + ordered_literal_coder]),
 ]
 
+textds_parallel_sa = [("SAParallel", "ds/SAParallel.hpp", [])]
+textds_parallel_phi = [("PhiParallel", "ds/PhiParallel.hpp", [])]
+textds_parallel_plcp = [("PLCPParallel", "ds/PLCPParallel.hpp", [])]
+textds_parallel_lcp = [("LCPParallel", "ds/LCPParallel.hpp", [])]
+
+textds_default_phi = [("PhiFromSA", "ds/PhiFromSA.hpp", [])]
+textds_default_plcp = [("PLCPFromPhi", "ds/PLCPFromPhi.hpp", [])]
+textds_external_sa = [("SAExternal", "ds/SAExternal.hpp", [])]
+textds_external_lcp = [("LCPExternal", "ds/LCPExternal.hpp", [])]
+
 textds = [
-    ("TextDS<>", "ds/TextDS.hpp", [])
+    ("TextDS<>", "ds/TextDS.hpp", []),
+]
+
+# Alternative constructions of the text data structures. Every user of
+# textds is a cartesian product, so these are only registered for lcpcomp
+# with a single coder (see below).
+textds_alternatives = [
+    ("TextDS<SAParallel>", "ds/SAParallel.hpp", []),
+    ("TextDS", "ds/TextDS.hpp", [textds_parallel_sa, textds_parallel_phi, textds_parallel_plcp, textds_parallel_lcp]),
+    ("TextDS", "ds/TextDS.hpp", [textds_external_sa, textds_default_phi, textds_default_plcp, textds_external_lcp]),
+]
+
+lcpc_default_strat = [
+    ("lcpcomp::MaxLCPStrategy", "compressors/lcpcomp/compress/MaxLCPStrategy.hpp", []),
+]
+
+lcpc_default_buffer = [
+    ("lcpcomp::CompactDec", "compressors/lcpcomp/decompress/CompactDec.hpp", []),
+]
+
+lcpc_textds_strat = lcpc_default_strat + [
+    ("lcpcomp::ArraysCompParallel", "compressors/lcpcomp/compress/ArraysCompParallel.hpp", []),
+]
+
+lcpc_textds_buffer = lcpc_default_buffer + [
+    ("lcpcomp::ParallelDec", "compressors/lcpcomp/decompress/ParallelDec.hpp", []),
+]
+
+lz78u_tree = [
+    ("lz78u::CSTSada",         "compressors/lz78u/SuffixTree.hpp",      []),
+    ("lz78u::LCPIntervalTree", "compressors/lz78u/LCPIntervalTree.hpp", [[("TextDS<>", "ds/TextDS.hpp", [])]]),
 ]
 
 compressors = [
     ("LCPCompressor",               "compressors/LCPCompressor.hpp",               [lcpc_coder, lcpc_strat, lcpc_buffer, textds]),
-    ("LZ78UCompressor",             "compressors/LZ78UCompressor.hpp",             [lz78u_strategy, context_free_coder]),
+    ("LCPCompressor",               "compressors/LCPCompressor.hpp",               [[("SLECoder", "coders/SLECoder.hpp", [])], lcpc_textds_strat, lcpc_textds_buffer, textds_alternatives]),
+    ("LCPCompressor",               "compressors/LCPCompressor.hpp",               [lcpc_block_coder, lcpc_default_strat, lcpc_default_buffer, textds]),
+    ("LZ78UCompressor",             "compressors/LZ78UCompressor.hpp",             [lz78u_strategy, context_free_coder, lz78u_tree]),
     ("RunLengthEncoder",            "compressors/RunLengthEncoder.hpp",            []),
-    ("LiteralEncoder",              "compressors/LiteralEncoder.hpp",              [coder]),
-    ("LZ78Compressor",              "compressors/LZ78Compressor.hpp",              [context_free_coder, lz78_trie]),
-    ("LZWCompressor",               "compressors/LZWCompressor.hpp",               [context_free_coder, lz78_trie]),
+    ("LiteralEncoder",              "compressors/LiteralEncoder.hpp",              [coder + ordered_literal_coder]),
+    ("LZ78Compressor",              "compressors/LZ78Compressor.hpp",              [context_free_coder + byte_coder, lz78_trie]),
+    ("LZWCompressor",               "compressors/LZWCompressor.hpp",               [context_free_coder + byte_coder, lz78_trie]),
     ("RePairCompressor",            "compressors/RePairCompressor.hpp",            [non_bit_interleaving_coder]),
-    ("LZSSLCPCompressor",           "compressors/LZSSLCPCompressor.hpp",           [non_bit_interleaving_coder, textds]),
-    ("LZSSSlidingWindowCompressor", "compressors/LZSSSlidingWindowCompressor.hpp", [context_free_coder]),
+    ("LZSSLCPCompressor",           "compressors/LZSSLCPCompressor.hpp",           [non_bit_interleaving_coder + ordered_literal_coder, textds]),
+    ("LZSSOptimalCompressor",       "compressors/LZSSOptimalCompressor.hpp",       [non_bit_interleaving_coder + ordered_literal_coder, textds]),
+    ("LZSSSlidingWindowCompressor", "compressors/LZSSSlidingWindowCompressor.hpp", [context_free_coder + block_coder]),
+    ("LZSSStreamCompressor",        "compressors/LZSSStreamCompressor.hpp",        [context_free_coder + block_coder, textds]),
     ("MTFCompressor",               "compressors/MTFCompressor.hpp",               []),
     ("NoopCompressor",              "compressors/NoopCompressor.hpp",              []),
     ("BWTCompressor",               "compressors/BWTCompressor.hpp",               [textds]),
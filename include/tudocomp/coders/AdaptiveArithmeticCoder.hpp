@@ -0,0 +1,341 @@
+#pragma once
+
+#include <vector>
+#include <tudocomp/util.hpp>
+#include <tudocomp/Coder.hpp>
+
+namespace tdc {
+
+/// \brief Adaptive binary arithmetic coding with context modelling.
+///
+/// Every value is decomposed into binary decisions, which are coded by a
+/// range coder using adaptive probabilities. Each kind of value has its own
+/// set of contexts:
+///
+/// - bits are modelled depending on the previous bit,
+/// - literals are coded bitwise in a binary tree, depending on the high bits
+///   of the previous literal,
+/// - integers of a \ref Range or \ref MinDistributedRange are split into
+///   their log2 bucket, which is coded in a binary tree, and their low bits,
+///   of which the highest ones are modelled per bucket.
+///
+/// No statistics need to be gathered in advance. The range coder's output
+/// is buffered and written as a single block when the encoder is destroyed,
+/// together with the amount of encoded values. Hence, the underlying stream
+/// must not be written to otherwise while the encoder is alive.
+class AdaptiveArithmeticCoder : public Algorithm {
+private:
+    typedef uint16_t prob_t;
+
+    static constexpr size_t PROB_BITS = 11;
+    static constexpr prob_t PROB_INIT = prob_t(1) << (PROB_BITS - 1);
+    static constexpr size_t ADAPT_SHIFT = 5;
+
+    static constexpr uint32_t TOP = 1U << 24;
+
+    /// The amount of high bits of the previous literal used as context.
+    static constexpr size_t LITERAL_CONTEXT_BITS = 3;
+
+    /// The amount of bits of a bucket index (covers buckets 0 to 64).
+    static constexpr size_t BUCKET_BITS = 7;
+
+    /// The amount of bits below the most significant bit that are modelled
+    /// per bucket, the remaining bits are coded directly.
+    static constexpr size_t MODELLED_BITS = 3;
+
+    /// \brief Context set for integers of a certain kind of range.
+    struct IntModel {
+        std::vector<prob_t> bucket;
+        std::vector<prob_t> low;
+
+        inline IntModel()
+            : bucket(1ULL << BUCKET_BITS, prob_t(PROB_INIT)),
+              low((65ULL) << MODELLED_BITS, prob_t(PROB_INIT)) {
+        }
+    };
+
+    /// \brief The contexts of all kinds of values.
+    struct Model {
+        prob_t bit[2];
+        bool last_bit;
+
+        std::vector<prob_t> literal;
+        uliteral_t last_literal;
+
+        IntModel range;
+        IntModel min_range;
+
+        inline Model()
+            : last_bit(false),
+              literal((1ULL << LITERAL_CONTEXT_BITS) << 8, prob_t(PROB_INIT)),
+              last_literal(0) {
+            bit[0] = bit[1] = PROB_INIT;
+        }
+
+        inline prob_t* literal_tree() {
+            return &literal[size_t(last_literal >> (8 - LITERAL_CONTEXT_BITS)) << 8];
+        }
+    };
+
+public:
+    inline static Meta meta() {
+        Meta m("coder", "adaptive_arithmetic",
+            "Adaptive binary arithmetic coding with context modelling");
+        return m;
+    }
+
+    AdaptiveArithmeticCoder() = delete;
+
+    class Encoder : public tdc::Encoder {
+    private:
+        Model m_model;
+        uint64_t m_count; // the amount of encoded values
+
+        std::vector<uint8_t> m_bytes;
+        uint64_t m_low;
+        uint32_t m_range;
+        uint8_t m_cache;
+        uint64_t m_cache_size;
+
+        inline void shift_low() {
+            if(uint32_t(m_low) < 0xFF000000U || (m_low >> 32) != 0) {
+                // the carry is known, emit the cached bytes
+                const uint8_t carry = uint8_t(m_low >> 32);
+                uint8_t temp = m_cache;
+                do {
+                    m_bytes.push_back(uint8_t(temp + carry));
+                    temp = 0xFF;
+                } while(--m_cache_size);
+                m_cache = uint8_t(m_low >> 24);
+            }
+            ++m_cache_size;
+            m_low = (m_low & 0x00FFFFFFULL) << 8;
+        }
+
+        inline void encode_bit(prob_t& p, bool bit) {
+            const uint32_t bound = (m_range >> PROB_BITS) * p;
+            if(!bit) {
+                m_range = bound;
+                p += ((prob_t(1) << PROB_BITS) - p) >> ADAPT_SHIFT;
+            } else {
+                m_low += bound;
+                m_range -= bound;
+                p -= p >> ADAPT_SHIFT;
+            }
+
+            while(m_range < TOP) {
+                m_range <<= 8;
+                shift_low();
+            }
+        }
+
+        inline void encode_direct(uint64_t v, size_t bits) {
+            while(bits--) {
+                m_range >>= 1;
+                if((v >> bits) & 1ULL) m_low += m_range;
+
+                while(m_range < TOP) {
+                    m_range <<= 8;
+                    shift_low();
+                }
+            }
+        }
+
+        inline void encode_tree(prob_t* tree, size_t v, size_t bits) {
+            size_t node = 1;
+            while(bits--) {
+                const bool bit = (v >> bits) & 1;
+                encode_bit(tree[node], bit);
+                node = (node << 1) | bit;
+            }
+        }
+
+        inline void encode_int(IntModel& model, uint64_t x) {
+            const size_t bucket = bits_hi(x);
+            encode_tree(model.bucket.data(), bucket, BUCKET_BITS);
+
+            if(bucket > 1) {
+                // the bits below the most significant bit
+                const size_t low_bits = bucket - 1;
+                const size_t modelled = std::min(low_bits, size_t(MODELLED_BITS));
+                const size_t direct = low_bits - modelled;
+
+                encode_tree(&model.low[bucket << MODELLED_BITS],
+                    (x >> direct) & ((1ULL << modelled) - 1), modelled);
+                encode_direct(x, direct);
+            }
+        }
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Env&& env, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(env), out, literals),
+              m_count(0),
+              m_low(0),
+              m_range(0xFFFFFFFFU),
+              m_cache(0),
+              m_cache_size(1) {
+        }
+
+        template<typename literals_t>
+        inline Encoder(Env&& env, Output& out, literals_t&& literals)
+            : Encoder(std::move(env), std::make_shared<BitOStream>(out), literals) {
+        }
+
+        inline ~Encoder() {
+            // flush the range coder
+            for(size_t i = 0; i < 5; ++i) shift_low();
+
+            m_out->write_compressed_int(m_count);
+            m_out->write_compressed_int(m_bytes.size());
+            for(uint8_t b : m_bytes) m_out->write_int(b);
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const Range& r) {
+            encode_int(m_model.range, uint64_t(v) - r.min());
+            ++m_count;
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const MinDistributedRange& r) {
+            encode_int(m_model.min_range, uint64_t(v) - r.min());
+            ++m_count;
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const BitRange&) {
+            const bool bit = bool(v);
+            encode_bit(m_model.bit[m_model.last_bit], bit);
+            m_model.last_bit = bit;
+            ++m_count;
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange&) {
+            const uliteral_t c = uliteral_t(v);
+            encode_tree(m_model.literal_tree(), c, 8);
+            m_model.last_literal = c;
+            ++m_count;
+        }
+    };
+
+    class Decoder : public tdc::Decoder {
+    private:
+        Model m_model;
+        uint64_t m_count; // the amount of values left to decode
+
+        std::vector<uint8_t> m_bytes;
+        size_t m_pos;
+        uint32_t m_code;
+        uint32_t m_range;
+
+        inline uint8_t next_byte() {
+            return (m_pos < m_bytes.size()) ? m_bytes[m_pos++] : 0;
+        }
+
+        inline bool decode_bit(prob_t& p) {
+            const uint32_t bound = (m_range >> PROB_BITS) * p;
+            bool bit;
+            if(m_code < bound) {
+                m_range = bound;
+                p += ((prob_t(1) << PROB_BITS) - p) >> ADAPT_SHIFT;
+                bit = false;
+            } else {
+                m_code -= bound;
+                m_range -= bound;
+                p -= p >> ADAPT_SHIFT;
+                bit = true;
+            }
+
+            while(m_range < TOP) {
+                m_range <<= 8;
+                m_code = (m_code << 8) | next_byte();
+            }
+            return bit;
+        }
+
+        inline uint64_t decode_direct(size_t bits) {
+            uint64_t v = 0;
+            while(bits--) {
+                m_range >>= 1;
+                const bool bit = (m_code >= m_range);
+                if(bit) m_code -= m_range;
+                v = (v << 1) | uint64_t(bit);
+
+                while(m_range < TOP) {
+                    m_range <<= 8;
+                    m_code = (m_code << 8) | next_byte();
+                }
+            }
+            return v;
+        }
+
+        inline size_t decode_tree(prob_t* tree, size_t bits) {
+            size_t node = 1;
+            for(size_t i = 0; i < bits; ++i) {
+                node = (node << 1) | size_t(decode_bit(tree[node]));
+            }
+            return node - (size_t(1) << bits);
+        }
+
+        inline uint64_t decode_int(IntModel& model) {
+            const size_t bucket = decode_tree(model.bucket.data(), BUCKET_BITS);
+            if(bucket <= 1) return bucket;
+
+            const size_t low_bits = bucket - 1;
+            const size_t modelled = std::min(low_bits, size_t(MODELLED_BITS));
+            const size_t direct = low_bits - modelled;
+
+            uint64_t x = 1ULL << low_bits;
+            x |= uint64_t(decode_tree(&model.low[bucket << MODELLED_BITS], modelled)) << direct;
+            x |= decode_direct(direct);
+            return x;
+        }
+
+    public:
+        DECODER_CTOR(env, in), m_pos(0), m_code(0), m_range(0xFFFFFFFFU) {
+            m_count = m_in->read_compressed_int<uint64_t>();
+            m_bytes.resize(m_in->read_compressed_int<size_t>());
+            for(auto& b : m_bytes) b = m_in->read_int<uint8_t>();
+
+            // the first byte is always zero
+            for(size_t i = 0; i < 5; ++i) m_code = (m_code << 8) | next_byte();
+        }
+
+        /// \brief Tests whether all encoded values have been decoded.
+        inline bool eof() const {
+            return m_count == 0;
+        }
+
+        template<typename value_t>
+        inline value_t decode(const Range& r) {
+            --m_count;
+            return value_t(decode_int(m_model.range) + r.min());
+        }
+
+        template<typename value_t>
+        inline value_t decode(const MinDistributedRange& r) {
+            --m_count;
+            return value_t(decode_int(m_model.min_range) + r.min());
+        }
+
+        template<typename value_t>
+        inline value_t decode(const BitRange&) {
+            --m_count;
+            const bool bit = decode_bit(m_model.bit[m_model.last_bit]);
+            m_model.last_bit = bit;
+            return value_t(bit);
+        }
+
+        template<typename value_t>
+        inline value_t decode(const LiteralRange&) {
+            --m_count;
+            const uliteral_t c = uliteral_t(decode_tree(m_model.literal_tree(), 8));
+            m_model.last_literal = c;
+            return value_t(c);
+        }
+    };
+};
+
+}
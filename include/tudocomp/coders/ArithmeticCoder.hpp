@@ -175,7 +175,7 @@ public:
     /// \brief Decodes data from an Arithmetic character stream.
     class Decoder : public tdc::Decoder {
     private:
-        std::vector<std::pair<literal_t ,int>> literals;
+        std::vector<std::pair<literal_t, len_t>> literals;
         std::string decoded;
         uliteral_t codebook_size;
         len_t literal_count = 0;
@@ -197,7 +197,7 @@ public:
                 ulong interval_lower_bound = lower_bound;
                 //search the right interval
                 for(int i = 0; i < codebook_size ; i++) {
-                    const std::pair<literal_t, int>& pair=literals[i];
+                    const std::pair<literal_t, len_t>& pair=literals[i];
                     const ulong offset = range <= interval_parts ? range*pair.second/interval_parts : range/interval_parts*pair.second;
                     upper_bound = lower_bound + offset;
                     if(code < upper_bound) {
@@ -226,8 +226,8 @@ public:
             //read and parse dictionary - is is already "normalized"
             for (int i =0; i<codebook_size; i++) {
                 literal_t c = m_in->read_int<literal_t>();
-                int val = m_in->read_int<int>();
-                literals[i]=std::pair<literal_t, int>(c, val);
+                len_t val = m_in->read_int<len_t>();
+                literals[i]=std::pair<literal_t, len_t>(c, val);
             }
 
             min_range=literals[codebook_size-1].second;
@@ -33,6 +33,15 @@ public:
         inline value_t decode(const Range&) {
             return m_in->read_elias_delta<value_t>();
         }
+
+        /// \brief Decodes \c count integers of the same range at once.
+        ///
+        /// \param out The array to store the values in.
+        /// \param count The amount of values to decode.
+        template<typename value_t>
+        inline void decode_many(const Range&, value_t* out, size_t count) {
+            m_in->read_elias_delta(out, count);
+        }
     };
 };
 
@@ -369,15 +369,70 @@ namespace huff {
             DVLOG(2) << "prefix_sum_lengths : " << arr_to_debug_string(prefix_sum_lengths, longest);
             return prefix_sum_lengths;
     }
+    /** The maximum number of bits that are looked up in the decoding table.
+     */
+    constexpr uint8_t max_lookup_bits = 10;
+
+    /** An entry of the decoding table, storing the literal whose codeword is a prefix of the entry's index.
+     * A length of zero marks that the codeword is longer than the indices.
+     */
+    struct lookup_entry {
+        uliteral_t literal;
+        uint8_t length;
+    };
+
+    /** Returns the number of bits used for table lookups. Needed for decoding Huffman code
+     */
+    inline uint8_t lookup_bits(const uint8_t longest) {
+        return std::min(longest, max_lookup_bits);
+    }
+
+    /**
+     * Generates a table that maps each bit string of length lookup_bits to the literal whose codeword is its prefix.
+     * Needed for decoding Huffman code
+     */
+    inline lookup_entry* gen_lookup_table(
+            const uliteral_t*const ordered_map_from_effective,
+            const size_t*const prefix_sum_lengths,
+            const size_t*const firstcodes,
+            const uint8_t bits) {
+        const size_t size = 1ULL << bits;
+        lookup_entry*const table = new lookup_entry[size];
+        for(size_t prefix = 0; prefix < size; ++prefix) {
+            table[prefix] = { 0, 0 };
+            for(uint8_t length = 1; length <= bits; ++length) {
+                const size_t value = prefix >> (bits - length);
+                if(value >= firstcodes[length-1]) {
+                    table[prefix] = { ordered_map_from_effective[prefix_sum_lengths[length-1] + (value - firstcodes[length-1])], length };
+                    break;
+                }
+            }
+        }
+        return table;
+    }
+
+    /**
+     * Decodes a single literal.
+     * The codeword is looked up in the table by its first bits, and only longer codewords are read bit by bit.
+     */
     inline literal_t huffman_decode(
             tdc::io::BitIStream& is,
             const uliteral_t*const ordered_map_from_effective,
             const size_t*const prefix_sum_lengths,
-            const size_t*const firstcodes
+            const size_t*const firstcodes,
+            const lookup_entry*const table,
+            const uint8_t bits
             ) {
         DCHECK(!is.eof());
-        size_t value = 0;
-        uint8_t length = 0;
+        size_t value = is.peek_int<size_t>(bits);
+        const lookup_entry& entry = table[value];
+        if(tdc_likely(entry.length > 0)) {
+            is.skip(entry.length);
+            return entry.literal;
+        }
+
+        is.skip(bits);
+        uint8_t length = bits;
         do {
             DCHECK(!is.eof());
             value = (value<<1) + is.read_bit();
@@ -387,8 +442,6 @@ namespace huff {
         --length;
 //      DCHECK_LT(prefix_sum_lengths[length]+ (value - firstcodes[length]), alphabet_size);
         return ordered_map_from_effective[prefix_sum_lengths[length]+ (value - firstcodes[length]) ];
-
-
     }
 
 
@@ -407,13 +460,17 @@ namespace huff {
             DCHECK_GT(text_length, 0);
             const size_t*const firstcodes = gen_first_codes(numl, longest);
             DVLOG(2) << "firstcodes : " << arr_to_debug_string(firstcodes, longest);
+            const uint8_t bits = lookup_bits(longest);
+            const lookup_entry*const table = gen_lookup_table(ordered_map_from_effective, prefix_sum_lengths, firstcodes, bits);
             size_t num_chars_read = 0;
             while(true) {
-                output << huffman_decode(is, ordered_map_from_effective, prefix_sum_lengths, firstcodes);
+                output << huffman_decode(is, ordered_map_from_effective, prefix_sum_lengths, firstcodes, table, bits);
                 ++num_chars_read;
                 if(num_chars_read == text_length) break;
             }
+            delete [] table;
             delete [] firstcodes;
+            delete [] prefix_sum_lengths;
     }
 
     /** Computes the lengths of all codewords of the Huffman code. Needed to decode a Huffman-encoded text.
@@ -568,12 +625,15 @@ public:
         const uliteral_t* ordered_map_from_effective;
         const size_t* prefix_sum_lengths;
         const size_t* firstcodes;
+        const huff::lookup_entry* lookup_table;
+        uint8_t lookup_bits;
     public:
         ~Decoder() {
             if(tdc_likely(ordered_map_from_effective != nullptr)) {
                 delete [] ordered_map_from_effective;
                 delete [] prefix_sum_lengths;
                 delete [] firstcodes;
+                delete [] lookup_table;
             }
         }
 
@@ -591,6 +651,8 @@ public:
             prefix_sum_lengths = huff::gen_prefix_sum_lengths(ordered_codelengths, table.alphabet_size, table.longest);
             delete [] ordered_codelengths;
             firstcodes = huff::gen_first_codes(table.numl, table.longest);
+            lookup_bits = huff::lookup_bits(table.longest);
+            lookup_table = huff::gen_lookup_table(ordered_map_from_effective, prefix_sum_lengths, firstcodes, lookup_bits);
         }
 
         inline Decoder(Env&& env, Input& in)
@@ -603,7 +665,7 @@ public:
         inline value_t decode(const LiteralRange&) {
             if(tdc_unlikely(ordered_map_from_effective == nullptr))
                 return m_in->read_int<uliteral_t>();
-            return huff::huffman_decode(*m_in, ordered_map_from_effective, prefix_sum_lengths, firstcodes);
+            return huff::huffman_decode(*m_in, ordered_map_from_effective, prefix_sum_lengths, firstcodes, lookup_table, lookup_bits);
         }
     };
 };
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <stdexcept>
+#include <vector>
+#include <tudocomp/util.hpp>
+#include <tudocomp/Coder.hpp>
+
+namespace tdc {
+
+/// \brief Static range asymmetric numeral systems (rANS) coder for literals.
+///
+/// The frequencies of the literals are counted using the literal iterator
+/// and scaled to a power of two. Since rANS encodes in reverse, the literals
+/// are coded in blocks: when the first literal of a block is encoded, the
+/// whole block is encoded ahead of time using the literal iterator's
+/// sequence, and the decoder decodes it in one go when the block's first
+/// literal is requested. Therefore, literals must be encoded in exactly the
+/// order in which the literal iterator yields them, otherwise the encoder
+/// throws a \c std::logic_error. Two states are interleaved so that
+/// consecutive literals can be decoded independently.
+///
+/// If the literal iterator is empty, literals are stored using eight bits.
+/// All other values are encoded like in the default encoder.
+class RANSCoder : public Algorithm {
+private:
+    /// The frequencies are scaled to sum up to 2^SCALE_BITS.
+    static constexpr size_t SCALE_BITS = 15;
+    static constexpr uint32_t SCALE = 1U << SCALE_BITS;
+
+    /// The lower bound of the states, which are renormalized in 16-bit words.
+    static constexpr uint32_t LOWER = 1U << 16;
+
+    /// The amount of literals coded in a block.
+    static constexpr size_t BLOCK_SIZE = 1ULL << 16;
+
+    /// \brief Scales literal counts to frequencies that sum up to SCALE.
+    ///
+    /// Every occurring literal keeps a frequency of at least one.
+    inline static std::vector<uint32_t> normalize(const std::vector<len_t>& counts) {
+        uint64_t total = 0;
+        for(auto c : counts) total += c;
+
+        std::vector<uint32_t> freq(counts.size(), 0);
+        uint64_t sum = 0;
+        size_t max = 0;
+        for(size_t c = 0; c < counts.size(); ++c) {
+            if(counts[c] == 0) continue;
+            freq[c] = std::max(uint64_t(1), (uint64_t(counts[c]) * SCALE) / total);
+            sum += freq[c];
+            if(freq[c] > freq[max]) max = c;
+        }
+
+        // correct the rounding errors
+        while(sum < SCALE) {
+            ++freq[max];
+            ++sum;
+        }
+        while(sum > SCALE) {
+            size_t c = 0;
+            for(size_t i = 0; i < freq.size(); ++i) {
+                if(freq[i] > freq[c]) c = i;
+            }
+            DCHECK_GT(freq[c], 1U);
+            --freq[c];
+            --sum;
+        }
+        return freq;
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("coder", "rans", "Static rANS coding with interleaved states");
+        return m;
+    }
+
+    RANSCoder() = delete;
+
+    class Encoder : public tdc::Encoder {
+    private:
+        std::vector<uliteral_t> m_literals;
+        len_t m_next;
+
+        std::vector<uint32_t> m_freq;
+        std::vector<uint32_t> m_start;
+
+        std::vector<uint16_t> m_words;
+
+        inline void encode_literal(uint32_t& x, uliteral_t c) {
+            const uint32_t freq = m_freq[c];
+
+            // renormalize
+            const uint64_t x_max = (uint64_t(LOWER >> SCALE_BITS) << 16) * freq;
+            if(x >= x_max) {
+                m_words.push_back(uint16_t(x));
+                x >>= 16;
+            }
+
+            x = ((x / freq) << SCALE_BITS) + (x % freq) + m_start[c];
+        }
+
+        inline void encode_block(len_t begin, len_t end) {
+            m_words.clear();
+
+            uint32_t x[2] = { LOWER, LOWER };
+            for(len_t i = end; i > begin; --i) {
+                encode_literal(x[(i - 1 - begin) & 1], m_literals[i - 1]);
+            }
+
+            // flush the states, so that the first state is read first
+            for(size_t k = 2; k > 0; --k) {
+                m_words.push_back(uint16_t(x[k-1]));
+                m_words.push_back(uint16_t(x[k-1] >> 16));
+            }
+
+            m_out->write_compressed_int(m_words.size());
+            for(size_t i = m_words.size(); i > 0; --i) {
+                m_out->write_int(m_words[i-1], 16);
+            }
+        }
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Env&& env, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(env), out, literals), m_next(0) {
+
+            std::vector<len_t> counts(ULITERAL_MAX+1, 0);
+            while(literals.has_next()) {
+                const uliteral_t c = literals.next().c;
+                m_literals.push_back(c);
+                ++counts[c];
+            }
+
+            if(m_literals.empty()) {
+                m_out->write_bit(0);
+                return;
+            }
+
+            m_freq = normalize(counts);
+            m_start.resize(m_freq.size());
+            for(size_t c = 0, s = 0; c < m_freq.size(); ++c) {
+                m_start[c] = s;
+                s += m_freq[c];
+            }
+
+            // write the header
+            m_out->write_bit(1);
+            m_out->write_compressed_int(m_literals.size());
+
+            size_t alphabet_size = 0;
+            for(auto f : m_freq) if(f) ++alphabet_size;
+            m_out->write_compressed_int(alphabet_size - 1);
+
+            for(size_t c = 0; c < m_freq.size(); ++c) {
+                if(m_freq[c] == 0) continue;
+                m_out->write_int(uliteral_t(c));
+                m_out->write_compressed_int(m_freq[c] - 1);
+            }
+        }
+
+        template<typename literals_t>
+        inline Encoder(Env&& env, Output& out, literals_t&& literals)
+            : Encoder(std::move(env), std::make_shared<BitOStream>(out), literals) {
+        }
+
+        using tdc::Encoder::encode; // default encoding as fallback
+
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange&) {
+            if(tdc_unlikely(m_literals.empty())) {
+                m_out->write_int(uliteral_t(v));
+                return;
+            }
+
+            // the blocks are encoded ahead of time, so any other literal
+            // would silently be replaced
+            if(tdc_unlikely(m_next >= m_literals.size()
+                || uliteral_t(v) != m_literals[m_next])) {
+                throw std::logic_error(
+                    "literals must be encoded in the order of the literal iterator");
+            }
+
+            if(m_next % BLOCK_SIZE == 0) {
+                encode_block(m_next, std::min(len_t(m_next + BLOCK_SIZE), len_t(m_literals.size())));
+            }
+            ++m_next;
+        }
+    };
+
+    class Decoder : public tdc::Decoder {
+    private:
+        bool m_raw;
+        len_t m_num_literals;
+        len_t m_decoded;
+
+        std::vector<uint32_t> m_freq;
+        std::vector<uint32_t> m_start;
+        std::vector<uliteral_t> m_slot_literal; // maps each slot to its literal
+
+        std::vector<uint16_t> m_words;
+        std::vector<uliteral_t> m_block;
+        size_t m_block_pos;
+
+        inline uliteral_t decode_literal(uint32_t& x, size_t& pos) {
+            const uint32_t slot = x & (SCALE - 1);
+            const uliteral_t c = m_slot_literal[slot];
+            x = m_freq[c] * (x >> SCALE_BITS) + slot - m_start[c];
+
+            // renormalize
+            if(x < LOWER) x = (x << 16) | m_words[pos++];
+            return c;
+        }
+
+        inline void decode_block() {
+            const len_t size = std::min(len_t(BLOCK_SIZE), len_t(m_num_literals - m_decoded));
+
+            m_words.resize(m_in->read_compressed_int<size_t>());
+            for(auto& w : m_words) w = m_in->read_int<uint16_t>(16);
+
+            uint32_t x[2];
+            x[0] = (uint32_t(m_words[0]) << 16) | m_words[1];
+            x[1] = (uint32_t(m_words[2]) << 16) | m_words[3];
+            size_t pos = 4;
+
+            m_block.resize(size);
+            for(len_t i = 0; i < size; ++i) {
+                m_block[i] = decode_literal(x[i & 1], pos);
+            }
+            DCHECK_EQ(pos, m_words.size());
+
+            m_decoded += size;
+            m_block_pos = 0;
+        }
+
+    public:
+        DECODER_CTOR(env, in), m_num_literals(0), m_decoded(0), m_block_pos(0) {
+            m_raw = !m_in->read_bit();
+            if(m_raw) return;
+
+            m_num_literals = m_in->read_compressed_int<len_t>();
+            const size_t alphabet_size = m_in->read_compressed_int<size_t>() + 1;
+
+            m_freq.resize(ULITERAL_MAX+1, 0);
+            for(size_t i = 0; i < alphabet_size; ++i) {
+                const uliteral_t c = m_in->read_int<uliteral_t>();
+                m_freq[c] = m_in->read_compressed_int<uint32_t>() + 1;
+            }
+
+            m_start.resize(m_freq.size());
+            m_slot_literal.resize(SCALE);
+            for(size_t c = 0, s = 0; c < m_freq.size(); ++c) {
+                m_start[c] = s;
+                for(size_t j = 0; j < m_freq[c]; ++j) m_slot_literal[s++] = c;
+            }
+        }
+
+        /// \brief Tests whether the end of the input has been reached and
+        ///        all decoded literals have been read.
+        inline bool eof() const {
+            return m_block_pos == m_block.size() && tdc::Decoder::eof();
+        }
+
+        using tdc::Decoder::decode; // default decoding as fallback
+
+        template<typename value_t>
+        inline value_t decode(const LiteralRange&) {
+            if(tdc_unlikely(m_raw)) return m_in->read_int<uliteral_t>();
+
+            if(m_block_pos == m_block.size()) decode_block();
+            return value_t(m_block[m_block_pos++]);
+        }
+    };
+};
+
+}
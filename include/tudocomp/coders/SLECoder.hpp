@@ -16,22 +16,46 @@ private:
         return (x & kmer_mask) == kmer_mask;
     }
 
-    static inline sym_t compile_kmer(const uliteral_t* kmer, size_t k) {
-        sym_t kmer_sym = 0;
-
+    static inline void decompile_kmer(sym_t x, uliteral_t* kmer, size_t k) {
         for(size_t i = 0; i < k; i++) {
-            kmer_sym |= (sym_t(kmer[k-1-i]) << 8UL * i);
+            kmer[k-1-i] = (x >> 8UL * i) & 0xFFUL;
         }
-
-        return kmer_sym | kmer_mask;
     }
 
-    static inline void decompile_kmer(sym_t x, uliteral_t* kmer, size_t k) {
-        for(size_t i = 0; i < k; i++) {
-            kmer[k-1-i] = (x >> 8UL * i) & 0xFFUL;
+    /// \brief A codeword, stored in the low \c len bits of \c bits.
+    struct code_t {
+        uint32_t bits;
+        uint32_t len;
+    };
+
+    /// \brief Computes the codeword of a symbol rank (see [Dinklage, 2015]).
+    static inline code_t code_for(size_t r, size_t sigma_bits) {
+        const uint32_t x = uint32_t(r);
+        if(sigma_bits < 4) {
+            return code_t { x, uint32_t(sigma_bits) };
+        } else if(sigma_bits < 6) {
+            if(r < 4) return code_t { x, 3 };
+            else      return code_t { (1U << sigma_bits) | x, uint32_t(1 + sigma_bits) };
+        } else if(sigma_bits == 6) {
+            if(r < 8)       return code_t { x, 5 };
+            else if(r < 16) return code_t { (1U << 3) | (x - 8), 5 };
+            else if(r < 32) return code_t { (2U << 4) | (x - 16), 6 };
+            else            return code_t { (3U << 6) | x, 8 };
+        } else {
+            if(r < 16)      return code_t { ((x / 4) << 2) | (x % 4), 5 };
+            else if(r < 40) return code_t { ((4 + (x - 16) / 8) << 3) | ((x - 16) % 8), 6 };
+            else            return code_t { (7U << sigma_bits) | x, uint32_t(3 + sigma_bits) };
         }
     }
 
+    /// \brief The length of the longest codeword.
+    static inline size_t max_code_length(size_t sigma_bits) {
+        if(sigma_bits < 4)       return sigma_bits;
+        else if(sigma_bits < 6)  return 1 + sigma_bits;
+        else if(sigma_bits == 6) return 8;
+        else                     return 3 + sigma_bits;
+    }
+
 public:
     inline static Meta meta() {
         Meta m("coder", "sle", "Static low entropy encoding conforming [Dinklage, 2015]");
@@ -45,12 +69,21 @@ public:
     private:
         size_t m_k;
 
-        uliteral_t* m_kmer;
+        // the current k-mer, packed with its last literal in the lowest byte
+        sym_t m_kmer;
+        sym_t m_kmer_word_mask;
         size_t m_kmer_cur;
 
-        Counter<sym_t>::ranking_t m_ranking;
         size_t m_sigma_bits;
 
+        // codewords of single literals
+        code_t m_literal_codes[ULITERAL_MAX+1];
+
+        // open addressing hash table of the k-mers in the alphabet
+        std::vector<sym_t> m_kmer_keys;
+        std::vector<code_t> m_kmer_codes;
+        size_t m_kmer_shift;
+
         inline bool kmer_full() {
             return m_kmer_cur == m_k;
         }
@@ -58,21 +91,47 @@ public:
         inline bool kmer_roll(uliteral_t c, uliteral_t& out) {
             bool roll_out = kmer_full();
             if(roll_out) {
-                out = m_kmer[0];
-
-                for(size_t i = 0; i < m_k - 1; i++) m_kmer[i] = m_kmer[i+1];
+                out = uliteral_t(m_kmer >> (8UL * (m_k - 1)));
                 --m_kmer_cur;
             }
 
-            m_kmer[m_kmer_cur++] = c;
+            m_kmer = ((m_kmer << 8UL) | sym_t(c)) & m_kmer_word_mask;
+            ++m_kmer_cur;
             return roll_out;
         }
 
-        //DEBUG
-        inline std::string kmer_str() {
-            std::ostringstream s;
-            for(size_t i = 0; i < m_k; i++) s << m_kmer[i];
-            return s.str();
+        inline size_t kmer_slot(sym_t x) const {
+            return size_t((x * 0x9E3779B97F4A7C15ULL) >> m_kmer_shift);
+        }
+
+        // returns the codeword of the k-mer, or nullptr if it is not in the
+        // alphabet
+        inline const code_t* find_kmer(sym_t x) const {
+            if(m_kmer_keys.empty()) return nullptr;
+
+            const size_t mask = m_kmer_keys.size() - 1;
+            for(size_t i = kmer_slot(x);; i = (i + 1) & mask) {
+                if(m_kmer_keys[i] == x) return &m_kmer_codes[i];
+                if(m_kmer_keys[i] == 0) return nullptr;
+            }
+        }
+
+        inline void build_kmer_table(const std::vector<std::pair<sym_t, code_t>>& kmers) {
+            size_t bits = 1;
+            while((1ULL << bits) < 2 * kmers.size()) ++bits;
+
+            m_kmer_shift = 64 - bits;
+            m_kmer_keys.assign(1ULL << bits, 0); // k-mers are never zero
+            m_kmer_codes.resize(1ULL << bits);
+
+            const size_t mask = m_kmer_keys.size() - 1;
+            for(auto& e : kmers) {
+                size_t i = kmer_slot(e.first);
+                while(m_kmer_keys[i] != 0) i = (i + 1) & mask;
+
+                m_kmer_keys[i] = e.first;
+                m_kmer_codes[i] = e.second;
+            }
         }
 
     public:
@@ -83,7 +142,8 @@ public:
             m_k     = this->env().option("kmer").as_integer();
             assert(m_k <= max_kmer);
 
-            m_kmer = new uliteral_t[m_k];
+            m_kmer_word_mask = (1UL << (8UL * m_k)) - 1UL;
+            m_kmer = 0;
             m_kmer_cur = 0;
             size_t last_literal_pos = 0;
 
@@ -104,11 +164,7 @@ public:
 
                     // count k-mer if complete
                     if(kmer_full()) {
-                        auto x = compile_kmer(m_kmer, m_k);
-                        //DLOG(INFO) << "count k-mer: " << kmer_str() <<
-                        //    " => 0x" << std::hex << x;
-
-                        kmers.increase(x);
+                        kmers.increase(m_kmer | kmer_mask);
                     }
                 }
 
@@ -128,10 +184,6 @@ public:
                 size_t eta = (1UL << (m_sigma_bits + eta_add_bits)) - sigma;
 
                 // merge eta most common k-mers into alphabet
-                /*DLOG(INFO) <<
-                    "sigma0 = " << sigma <<
-                    ", eta = " << eta <<
-                    ", kmers = " << kmers.getNumItems();*/
                 for(auto e : kmers.getSorted()) {
                     alphabet.setCount(e.first, e.second);
                     if(--eta == 0) break; //no more than eta
@@ -142,24 +194,20 @@ public:
                 m_sigma_bits = bits_for(sigma - 1);
             }
 
-            // create ranking
-            m_ranking  = alphabet.createRanking();
-
-            // debug
-            /*{
-                DLOG(INFO) << "m_sigma_bits = " << m_sigma_bits;
-                DLOG(INFO) << "ranking:";
-                for(auto e : m_ranking) {
-                    DLOG(INFO) << "\t'" << std::hex << e.first << "' -> " <<
-                        std::dec << e.second << ", is_kmer = " << is_kmer(e.first);
-                }
-            }*/
+            // encode ranking and assign codewords
+            const auto ranking = alphabet.getSorted();
+            std::vector<std::pair<sym_t, code_t>> kmer_codes;
 
-            // encode ranking
             m_out->write_compressed_int(sigma);
-            for(auto e : alphabet.getSorted()) {
-                m_out->write_compressed_int(e.first);
+            for(size_t r = 0; r < ranking.size(); ++r) {
+                const sym_t x = ranking[r].first;
+                m_out->write_compressed_int(x);
+
+                const code_t code = code_for(r, m_sigma_bits);
+                if(is_kmer(x)) kmer_codes.emplace_back(x, code);
+                else           m_literal_codes[x] = code;
             }
+            build_kmer_table(kmer_codes);
 
             // reset current k-mer
             m_kmer_cur = 0;
@@ -173,101 +221,57 @@ public:
         ~Encoder() {
             // flush
             flush_kmer();
-
-            // clean up
-            delete[] m_kmer;
         }
 
     private:
         inline void flush_kmer() {
             // encode literals in k-mer buffer
-            for(size_t i = 0; i < m_kmer_cur; i++) {
-                encode_sym(sym_t(m_kmer[i]));
+            for(size_t i = m_kmer_cur; i > 0; i--) {
+                encode_code(m_literal_codes[uliteral_t(m_kmer >> (8UL * (i - 1)))]);
             }
 
             // reset current k-mer
             m_kmer_cur = 0;
         }
 
-        inline void encode_sym(sym_t x) {
-            auto r = m_ranking[x];
-            //DLOG(INFO) << "encode_sym(0x" << std::hex << x << "), r = " << std::dec << r;
-
-            // see [Dinklage, 2015]
-            if(m_sigma_bits < 4) {
-                m_out->write_int(r, m_sigma_bits);
-            } else if(m_sigma_bits < 6) {
-                if(r < 4) {
-                    m_out->write_bit(0);
-                    m_out->write_int(r, 2);
-                } else {
-                    m_out->write_bit(1);
-                    m_out->write_int(r, m_sigma_bits);
-                }
-            } else if(m_sigma_bits == 6) {
-                if(r < 8) {
-                    m_out->write_int(0, 2);
-                    m_out->write_int(r, 3);
-                } else if(r < 16) {
-                    m_out->write_int(1, 2);
-                    m_out->write_int(r - 8UL, 3);
-                } else if(r < 32) {
-                    m_out->write_int(2, 2);
-                    m_out->write_int(r - 16UL, 4);
-                } else {
-                    m_out->write_int(3, 2);
-                    m_out->write_int(r, m_sigma_bits);
-                }
-            } else {
-                if(r < 4) {
-                    m_out->write_int(0, 3);
-                    m_out->write_int(r, 2);
-                } else if(r < 8) {
-                    m_out->write_int(1, 3);
-                    m_out->write_int(r - 4UL, 2);
-                } else if(r < 12) {
-                    m_out->write_int(2, 3);
-                    m_out->write_int(r - 8UL, 2);
-                } else if(r < 16) {
-                    m_out->write_int(3, 3);
-                    m_out->write_int(r - 12UL, 2);
-                } else if(r < 24) {
-                    m_out->write_int(4, 3);
-                    m_out->write_int(r - 16UL, 3);
-                } else if(r < 32) {
-                    m_out->write_int(5, 3);
-                    m_out->write_int(r - 24UL, 3);
-                } else if(r < 40) {
-                    m_out->write_int(6, 3);
-                    m_out->write_int(r - 32UL, 3);
-                } else {
-                    m_out->write_int(7, 3);
-                    m_out->write_int(r, m_sigma_bits);
-                }
-            }
+        inline void encode_code(const code_t& code) {
+            m_out->write_int(code.bits, code.len);
         }
 
-    public:
-        template<typename value_t>
-        inline void encode(value_t v, const LiteralRange&) {
-            auto c = uliteral_t(v);
-
+        inline void encode_literal(uliteral_t c) {
             uliteral_t out = 0;
             if(kmer_roll(c, out)) {
                 // encode rolled out character
-                encode_sym(sym_t(out));
+                encode_code(m_literal_codes[out]);
             }
 
             if(kmer_full()) {
-                sym_t x = compile_kmer(m_kmer, m_k);
-                if(m_ranking.find(x) != m_ranking.end()) {
-                    // current k-mer exists in ranking
-                    encode_sym(x);
+                const code_t* code = find_kmer(m_kmer | kmer_mask);
+                if(code) {
+                    // current k-mer exists in alphabet
+                    encode_code(*code);
                     m_kmer_cur = 0; // reset
                 }
             }
         }
 
+    public:
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange&) {
+            encode_literal(uliteral_t(v));
+        }
+
+        /// \brief Encodes a run of consecutive literals.
+        ///
+        /// This is equivalent to encoding each literal separately.
+        ///
+        /// \param literals The literals to encode.
+        inline void encode_literals(const View& literals) {
+            for(size_t i = 0; i < literals.size(); ++i) {
+                encode_literal(literals[i]);
+            }
+        }
+
         template<typename value_t>
         inline void encode(value_t v, const Range& r) {
             flush_kmer(); // k-mer interrupted
@@ -313,9 +317,13 @@ public:
         size_t m_k;
 
         size_t m_sigma_bits;
-        sym_t* m_inv_ranking;
+        std::vector<sym_t> m_inv_ranking;
+
+        // maps the next codeword bits to the symbol rank and codeword length
+        std::vector<code_t> m_table;
+        size_t m_table_bits;
 
-        uliteral_t* m_kmer;
+        uliteral_t m_kmer[max_kmer];
         size_t m_kmer_read;
 
         inline void reset_kmer() {
@@ -326,23 +334,30 @@ public:
         inline Decoder(Env&& env, std::shared_ptr<BitIStream> in)
             : tdc::Decoder(std::move(env), in) {
             m_k = this->env().option("kmer").as_integer();
-
-            m_kmer = new uliteral_t[m_k];
             reset_kmer();
 
             // decode literal ranking
             auto sigma = m_in->read_compressed_int<size_t>();
 
             m_sigma_bits = bits_for(sigma - 1);
-            m_inv_ranking = new sym_t[sigma];
+            m_inv_ranking.resize(sigma);
 
             for(size_t rank = 0; rank < sigma; rank++) {
-                auto c = m_in->read_compressed_int<sym_t>();
+                m_inv_ranking[rank] = m_in->read_compressed_int<sym_t>();
+            }
 
-                //DLOG(INFO) << "decoded rank: " << rank << " -> " <<
-                //    std::hex << c << ", is_kmer = " << is_kmer(c);
+            // build the decoding table, in which every codeword occupies
+            // all entries that it is a prefix of
+            m_table_bits = (sigma > 0) ? max_code_length(m_sigma_bits) : 0;
+            m_table.resize(1ULL << m_table_bits, code_t { 0, uint32_t(m_table_bits) });
 
-                m_inv_ranking[rank] = c;
+            for(size_t rank = 0; rank < sigma; rank++) {
+                const code_t code = code_for(rank, m_sigma_bits);
+                const size_t shift = m_table_bits - code.len;
+                const size_t first = size_t(code.bits) << shift;
+                for(size_t i = 0; i < (1ULL << shift); i++) {
+                    m_table[first + i] = code_t { uint32_t(rank), code.len };
+                }
             }
         }
 
@@ -350,11 +365,6 @@ public:
             : Decoder(std::move(env), std::make_shared<BitIStream>(in)) {
         }
 
-        ~Decoder() {
-            delete[] m_kmer;
-            delete[] m_inv_ranking;
-        }
-
         inline bool eof() const {
             if(m_kmer_read < m_k) {
                 // still decoding a k-mer
@@ -372,39 +382,10 @@ public:
                 return value_t(m_kmer[m_kmer_read++]);
             }
 
-            size_t r = 0;
-
-            // see [Dinklage, 2015]
-            if(m_sigma_bits < 4) {
-                r = m_in->read_int<size_t>(m_sigma_bits);
-            } else if(m_sigma_bits < 6) {
-                auto b = m_in->read_bit();
-                if(b == 0) r = m_in->read_int<size_t>(2);
-                else       r = m_in->read_int<size_t>(m_sigma_bits);
-            } else if(m_sigma_bits == 6) {
-                auto x = m_in->read_int<uint8_t>(2);
-                switch(x) {
-                    case 0: r = m_in->read_int<size_t>(3); break;
-                    case 1: r = 8UL + m_in->read_int<size_t>(3); break;
-                    case 2: r = 16UL + m_in->read_int<size_t>(4); break;
-                    case 3: r = m_in->read_int<size_t>(m_sigma_bits); break;
-                }
-            } else {
-                auto x = m_in->read_int<uint8_t>(3);
-                switch(x) {
-                    case 0: r = m_in->read_int<size_t>(2); break;
-                    case 1: r = 4UL + m_in->read_int<size_t>(2); break;
-                    case 2: r = 8UL + m_in->read_int<size_t>(2); break;
-                    case 3: r = 12UL + m_in->read_int<size_t>(2); break;
-                    case 4: r = 16UL + m_in->read_int<size_t>(3); break;
-                    case 5: r = 24UL + m_in->read_int<size_t>(3); break;
-                    case 6: r = 32UL + m_in->read_int<size_t>(3); break;
-                    case 7: r = m_in->read_int<size_t>(m_sigma_bits); break;
-                }
-            }
+            const code_t& e = m_table[m_in->peek_int<size_t>(m_table_bits)];
+            m_in->skip(e.len);
 
-            auto x = m_inv_ranking[r];
-            //DLOG(INFO) << "decoded 0x" << std::hex << x << " from r = " << std::dec << r;
+            auto x = m_inv_ranking[e.bits];
 
             if(is_kmer(x)) {
                 decompile_kmer(x, m_kmer, m_k);
@@ -452,4 +433,3 @@ public:
 };
 
 }
-
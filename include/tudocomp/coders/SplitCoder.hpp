@@ -0,0 +1,184 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <tudocomp/util.hpp>
+#include <tudocomp/Coder.hpp>
+
+namespace tdc {
+
+/// \brief Codes each kind of value into its own substream.
+///
+/// Literals, bits, integers of a \ref MinDistributedRange (e.g. factor
+/// lengths) and integers of any other \ref Range (e.g. factor sources) are
+/// passed to four independent coders, each writing to a buffered substream.
+/// This way, every kind of value is entropy coded with its own model.
+///
+/// When the encoder is destroyed, the substreams are written to the output
+/// following a directory of their sizes. The decoder reads them all at
+/// construction, so every substream could also be decoded in bulk.
+/// Hence, the underlying stream must not be written to otherwise while the
+/// encoder is alive.
+///
+/// \tparam literal_coder_t the coder for literals.
+/// \tparam bit_coder_t the coder for bits.
+/// \tparam range_coder_t the coder for integers of a generic range.
+/// \tparam length_coder_t the coder for integers of a
+///                        \ref MinDistributedRange.
+template<typename literal_coder_t, typename bit_coder_t,
+         typename range_coder_t, typename length_coder_t>
+class SplitCoder : public Algorithm {
+private:
+    static constexpr size_t LITERALS = 0;
+    static constexpr size_t BITS = 1;
+    static constexpr size_t RANGES = 2;
+    static constexpr size_t LENGTHS = 3;
+
+    static constexpr size_t NUM_STREAMS = 4;
+
+public:
+    inline static Meta meta() {
+        Meta m("coder", "split", "Codes each kind of value into its own substream");
+        m.option("literals").templated<literal_coder_t>("coder");
+        m.option("bits").templated<bit_coder_t>("coder");
+        m.option("ranges").templated<range_coder_t>("coder");
+        m.option("lengths").templated<length_coder_t>("coder");
+        return m;
+    }
+
+    SplitCoder() = delete;
+
+    class Encoder : public tdc::Encoder {
+    private:
+        std::vector<uint8_t> m_buffers[NUM_STREAMS];
+
+        std::unique_ptr<typename literal_coder_t::Encoder> m_literals;
+        std::unique_ptr<typename bit_coder_t::Encoder> m_bits;
+        std::unique_ptr<typename range_coder_t::Encoder> m_ranges;
+        std::unique_ptr<typename length_coder_t::Encoder> m_lengths;
+
+        inline std::shared_ptr<BitOStream> substream(size_t i) {
+            Output out(m_buffers[i]);
+            return std::make_shared<BitOStream>(out);
+        }
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Env&& env, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(env), out, literals) {
+
+            m_literals = std::make_unique<typename literal_coder_t::Encoder>(
+                this->env().env_for_option("literals"), substream(LITERALS), literals);
+            m_bits = std::make_unique<typename bit_coder_t::Encoder>(
+                this->env().env_for_option("bits"), substream(BITS), NoLiterals());
+            m_ranges = std::make_unique<typename range_coder_t::Encoder>(
+                this->env().env_for_option("ranges"), substream(RANGES), NoLiterals());
+            m_lengths = std::make_unique<typename length_coder_t::Encoder>(
+                this->env().env_for_option("lengths"), substream(LENGTHS), NoLiterals());
+        }
+
+        template<typename literals_t>
+        inline Encoder(Env&& env, Output& out, literals_t&& literals)
+            : Encoder(std::move(env), std::make_shared<BitOStream>(out), literals) {
+        }
+
+        inline ~Encoder() {
+            // flush the substreams
+            m_literals.reset();
+            m_bits.reset();
+            m_ranges.reset();
+            m_lengths.reset();
+
+            // write the directory, followed by the substreams
+            for(auto& buffer : m_buffers) {
+                m_out->write_compressed_int(buffer.size());
+            }
+            for(auto& buffer : m_buffers) {
+                for(uint8_t b : buffer) m_out->write_int(b);
+            }
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const Range& r) {
+            m_ranges->encode(v, r);
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const MinDistributedRange& r) {
+            m_lengths->encode(v, r);
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const BitRange& r) {
+            m_bits->encode(v, r);
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange& r) {
+            m_literals->encode(v, r);
+        }
+    };
+
+    class Decoder : public tdc::Decoder {
+    private:
+        std::vector<uint8_t> m_buffers[NUM_STREAMS];
+
+        std::unique_ptr<typename literal_coder_t::Decoder> m_literals;
+        std::unique_ptr<typename bit_coder_t::Decoder> m_bits;
+        std::unique_ptr<typename range_coder_t::Decoder> m_ranges;
+        std::unique_ptr<typename length_coder_t::Decoder> m_lengths;
+
+        inline std::shared_ptr<BitIStream> substream(size_t i) {
+            Input in(m_buffers[i]);
+            return std::make_shared<BitIStream>(in);
+        }
+
+    public:
+        DECODER_CTOR(env, in) {
+            // read the directory, followed by the substreams
+            for(auto& buffer : m_buffers) {
+                buffer.resize(m_in->read_compressed_int<size_t>());
+            }
+            for(auto& buffer : m_buffers) {
+                for(auto& b : buffer) b = m_in->read_int<uint8_t>();
+            }
+
+            m_literals = std::make_unique<typename literal_coder_t::Decoder>(
+                this->env().env_for_option("literals"), substream(LITERALS));
+            m_bits = std::make_unique<typename bit_coder_t::Decoder>(
+                this->env().env_for_option("bits"), substream(BITS));
+            m_ranges = std::make_unique<typename range_coder_t::Decoder>(
+                this->env().env_for_option("ranges"), substream(RANGES));
+            m_lengths = std::make_unique<typename length_coder_t::Decoder>(
+                this->env().env_for_option("lengths"), substream(LENGTHS));
+        }
+
+        /// \brief Tests whether all substreams have been decoded completely.
+        inline bool eof() const {
+            return m_literals->eof() && m_bits->eof() &&
+                   m_ranges->eof() && m_lengths->eof();
+        }
+
+        template<typename value_t>
+        inline value_t decode(const Range& r) {
+            return m_ranges->template decode<value_t>(r);
+        }
+
+        template<typename value_t>
+        inline value_t decode(const MinDistributedRange& r) {
+            return m_lengths->template decode<value_t>(r);
+        }
+
+        template<typename value_t>
+        inline value_t decode(const BitRange& r) {
+            return m_bits->template decode<value_t>(r);
+        }
+
+        template<typename value_t>
+        inline value_t decode(const LiteralRange& r) {
+            return m_literals->template decode<value_t>(r);
+        }
+    };
+};
+
+}
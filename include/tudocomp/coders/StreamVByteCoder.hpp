@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <tudocomp/util.hpp>
+#include <tudocomp/util/streamvbyte.hpp>
+#include <tudocomp/Coder.hpp>
+
+namespace tdc {
+
+/// \brief Encodes integers in the Stream VByte format.
+///
+/// Integers of a \ref Range are collected and stored in the Stream VByte
+/// format, so that the decoder can decode them all at once using SIMD
+/// shuffles. Integers of ranges exceeding 32 bits are stored as two
+/// integers. Bits and literals are written to a separate bit stream.
+///
+/// When the encoder is destroyed, both streams are written to the output.
+/// Hence, the underlying stream must not be written to otherwise while the
+/// encoder is alive.
+class StreamVByteCoder : public Algorithm {
+private:
+    inline static bool is_wide(const Range& r) {
+        return r.delta() > std::numeric_limits<uint32_t>::max();
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("coder", "stream_vbyte", "Stream VByte encoding of integers");
+        return m;
+    }
+
+    StreamVByteCoder() = delete;
+
+    class Encoder : public tdc::Encoder {
+    private:
+        std::vector<uint32_t> m_values;
+
+        std::vector<uint8_t> m_bits_buffer;
+        std::shared_ptr<BitOStream> m_bits;
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Env&& env, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(env), out, literals) {
+            Output bits_out(m_bits_buffer);
+            m_bits = std::make_shared<BitOStream>(bits_out);
+        }
+
+        template<typename literals_t>
+        inline Encoder(Env&& env, Output& out, literals_t&& literals)
+            : Encoder(std::move(env), std::make_shared<BitOStream>(out), literals) {
+        }
+
+        inline ~Encoder() {
+            m_bits.reset(); // flush
+
+            std::vector<uint8_t> bytes(stream_vbyte_max_bytes(m_values.size()));
+            bytes.resize(encode_stream_vbyte(m_values.data(), m_values.size(), bytes.data()));
+
+            m_out->write_compressed_int(m_values.size());
+            m_out->write_compressed_int(bytes.size());
+            m_out->write_compressed_int(m_bits_buffer.size());
+            m_out->write_bytes(bytes.data(), bytes.size());
+            m_out->write_bytes(m_bits_buffer.data(), m_bits_buffer.size());
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const Range& r) {
+            const uint64_t x = uint64_t(v) - r.min();
+            if(is_wide(r)) m_values.push_back(uint32_t(x >> 32));
+            m_values.push_back(uint32_t(x));
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const BitRange&) {
+            m_bits->write_bit(v);
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange&) {
+            m_bits->write_int(uliteral_t(v));
+        }
+    };
+
+    class Decoder : public tdc::Decoder {
+    private:
+        std::vector<uint32_t> m_values;
+        size_t m_next;
+
+        std::vector<uint8_t> m_bits_buffer;
+        std::shared_ptr<BitIStream> m_bits;
+
+    public:
+        DECODER_CTOR(env, in), m_next(0) {
+            m_values.resize(m_in->read_compressed_int<size_t>());
+            std::vector<uint8_t> bytes(m_in->read_compressed_int<size_t>());
+            m_bits_buffer.resize(m_in->read_compressed_int<size_t>());
+            m_in->read_bytes(bytes.data(), bytes.size());
+            m_in->read_bytes(m_bits_buffer.data(), m_bits_buffer.size());
+
+            // decode all integers at once
+            decode_stream_vbyte(bytes.data(), bytes.size(), m_values.data(), m_values.size());
+
+            Input bits_in(m_bits_buffer);
+            m_bits = std::make_shared<BitIStream>(bits_in);
+        }
+
+        /// \brief Tests whether all integers, bits and literals have been
+        ///        decoded.
+        inline bool eof() const {
+            return m_next == m_values.size() && m_bits->eof();
+        }
+
+        template<typename value_t>
+        inline value_t decode(const Range& r) {
+            uint64_t x = 0;
+            if(is_wide(r)) x = uint64_t(m_values[m_next++]) << 32;
+            x |= m_values[m_next++];
+            return value_t(x + r.min());
+        }
+
+        template<typename value_t>
+        inline value_t decode(const BitRange&) {
+            return value_t(m_bits->read_bit());
+        }
+
+        template<typename value_t>
+        inline value_t decode(const LiteralRange&) {
+            return value_t(m_bits->read_int<uliteral_t>());
+        }
+    };
+};
+
+}
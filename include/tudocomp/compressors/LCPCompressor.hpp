@@ -1,6 +1,7 @@
 #pragma once
 
 #include <tudocomp/util.hpp>
+#include <tudocomp/util/parallel.hpp>
 
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/compressors/lzss/LZSSCoding.hpp>
@@ -15,6 +16,18 @@ namespace tdc {
 namespace lcpcomp {
 class MaxLCPStrategy;
 class CompactDec;
+class ParallelDec;
+
+template<typename decode_buffer_t>
+inline void log_longest_chain(const decode_buffer_t& buffer) {
+    StatPhase::log("longest_chain", buffer.longest_chain());
+}
+
+/// Nothing is logged for the parallel decoder, which does not know its
+/// dependency chains. Its rounds are logged as "rounds" by
+/// \ref ParallelDec::decode_lazy.
+inline void log_longest_chain(const ParallelDec&) {
+}
 
 template<typename coder_t, typename decode_buffer_t>
 inline void decode_text_internal(Env&& env, coder_t& decoder, std::ostream& outs) {
@@ -66,7 +79,7 @@ inline void decode_text_internal(Env&& env, coder_t& decoder, std::ostream& outs
     StatPhase::wrap("Scan Decoding", [&]{ buffer.decode_lazy(); });
     StatPhase::wrap("Eager Decoding", [&]{
         buffer.decode_eagerly();
-        IF_STATS(StatPhase::log("longest_chain", buffer.longest_chain()));
+        IF_STATS(log_longest_chain(buffer));
     });
     StatPhase::wrap("Output Text", [&]{ buffer.write_to(outs); });
 }
@@ -75,26 +88,17 @@ inline void decode_text_internal(Env&& env, coder_t& decoder, std::ostream& outs
 
 /// Factorizes the input by finding redundant phrases in a re-ordered version
 /// of the LCP table.
+///
+/// If a block size is given, the input is cut into blocks of that size, which
+/// are factorized independently and in parallel, each with its own text data
+/// structures. This bounds the memory needed for the text data structures by
+/// that of \c threads blocks. The compressed blocks are followed by an index
+/// of their sizes, so they can be decompressed in parallel as well.
 template<typename coder_t, typename strategy_t, typename dec_t, typename text_t = TextDS<>>
 class LCPCompressor : public Compressor {
-public:
-    inline static Meta meta() {
-        Meta m("compressor", "lcpcomp");
-        m.option("coder").templated<coder_t>("coder");
-        m.option("comp").templated<strategy_t, lcpcomp::MaxLCPStrategy>("lcpcomp_comp");
-        m.option("dec").templated<dec_t, lcpcomp::CompactDec>("lcpcomp_dec");
-        m.option("textds").templated<text_t, TextDS<>>("textds");
-        m.option("threshold").dynamic(3);
-        m.uses_textds<text_t>(strategy_t::textds_flags());
-        return m;
-    }
-
-    /// Construct the class with an environment.
-    inline LCPCompressor(Env&& env) : Compressor(std::move(env)) {}
-
-    inline virtual void compress(Input& input, Output& output) override {
-        auto in = input.as_view();
-        DCHECK(in.ends_with(uint8_t(0)));
+private:
+    /// Factorizes and encodes a sentinel-terminated text.
+    inline void compress_text(const View& in, Output& output) {
         text_t text(env().env_for_option("textds"), in, strategy_t::textds_flags());
 
         // read options
@@ -124,19 +128,165 @@ public:
         });
     }
 
+    /// Decodes a text, including its sentinel.
+    inline void decompress_text(Input& input, std::ostream& outs) {
+        typename coder_t::Decoder decoder(env().env_for_option("coder"), input);
+        lcpcomp::decode_text_internal<typename coder_t::Decoder, dec_t>(env().env_for_option("dec"), decoder, outs);
+    }
+
+    // block index entries are stored as 64-bit little endian integers
+    inline static void write_index_entry(std::ostream& outs, uint64_t v) {
+        for(size_t i = 0; i < 8; ++i) outs.put(char((v >> (8 * i)) & 0xFF));
+    }
+
+    inline static uint64_t read_index_entry(const View& in, size_t pos) {
+        uint64_t v = 0;
+        for(size_t i = 0; i < 8; ++i) v |= uint64_t(uint8_t(in[pos + i])) << (8 * i);
+        return v;
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("compressor", "lcpcomp");
+        m.option("coder").templated<coder_t>("coder");
+        m.option("comp").templated<strategy_t, lcpcomp::MaxLCPStrategy>("lcpcomp_comp");
+        m.option("dec").templated<dec_t, lcpcomp::CompactDec>("lcpcomp_dec");
+        m.option("textds").templated<text_t, TextDS<>>("textds");
+        m.option("threshold").dynamic(3);
+        m.option("block_size").dynamic(0);
+        m.option("threads").dynamic(0);
+        m.uses_textds<text_t>(strategy_t::textds_flags());
+        return m;
+    }
+
+    /// Construct the class with an environment.
+    inline LCPCompressor(Env&& env) : Compressor(std::move(env)) {}
+
+    inline virtual void compress(Input& input, Output& output) override {
+        auto in = input.as_view();
+        DCHECK(in.ends_with(uint8_t(0)));
+
+        const size_t block_size = env().option("block_size").as_integer();
+        if(block_size == 0) {
+            compress_text(in, output);
+            return;
+        }
+
+        const size_t threads = parallel::num_threads(
+            env().option("threads").as_integer());
+
+        const size_t n = in.size() - 1; // without the sentinel
+        const size_t num_blocks = idiv_ceil(n, block_size);
+
+        auto outs = output.as_stream();
+        std::vector<uint64_t> index;
+
+        StatPhase::wrap("Compress Blocks", [&]{
+            // allocations of the other threads are not tracked (see
+            // parallel::run), so the blocks are copied into buffers
+            // allocated here
+            std::vector<std::vector<uint8_t>> texts(threads);
+            for(auto& text : texts) text.reserve(block_size + 1);
+            std::vector<std::vector<uint8_t>> compressed(threads);
+
+            // compress up to one block per thread at a time
+            for(size_t first = 0; first < num_blocks; first += threads) {
+                const size_t wave = std::min(threads, num_blocks - first);
+
+                parallel::run(wave, [&](size_t tid){
+                    const size_t b = (first + tid) * block_size;
+                    const size_t e = std::min(n, b + block_size);
+
+                    // copy the block and terminate it
+                    auto& text = texts[tid];
+                    text.assign(in.data() + b, in.data() + e);
+                    text.push_back(0);
+
+                    Output out = Output::from_memory(compressed[tid]);
+                    compress_text(View(text), out);
+                });
+
+                for(size_t tid = 0; tid < wave; ++tid) {
+                    auto& block = compressed[tid];
+                    outs.write((const char*)block.data(), block.size());
+                    index.push_back(block.size());
+
+                    // the size of the compressed block is not known in
+                    // advance, so the buffer of another thread is tracked
+                    // here before it is released
+                    if(tid > 0) StatPhase::track_alloc(block.capacity());
+                    std::vector<uint8_t>().swap(block);
+                }
+            }
+
+            StatPhase::log("blocks", num_blocks);
+            StatPhase::log("threads", threads);
+        });
+
+        // write block index
+        for(auto size : index) write_index_entry(outs, size);
+        write_index_entry(outs, num_blocks);
+    }
+
     inline virtual void decompress(Input& input, Output& output) override {
         //TODO: tell that forward-factors are allowed
-        typename coder_t::Decoder decoder(env().env_for_option("coder"), input);
         auto outs = output.as_stream();
 
+        const size_t block_size = env().option("block_size").as_integer();
+        if(block_size == 0) {
+            decompress_text(input, outs);
+            return;
+        }
+
+        const size_t threads = parallel::num_threads(
+            env().option("threads").as_integer());
 
-        //lzss::decode_text_internal<coder_t, dec_t>(decoder, outs);
-        // if(lazy == 0)
-        // 	lzss::decode_text_internal<coder_t, dec_t>(decoder, outs);
-        // else
-        lcpcomp::decode_text_internal<typename coder_t::Decoder, dec_t>(env().env_for_option("dec"), decoder, outs);
+        auto in = input.as_view();
+
+        // read block index
+        const size_t num_blocks = read_index_entry(in, in.size() - 8);
+        const size_t index_pos = in.size() - 8 * (num_blocks + 1);
+
+        std::vector<size_t> offsets(num_blocks + 1, 0);
+        for(size_t i = 0; i < num_blocks; ++i) {
+            offsets[i+1] = offsets[i] + read_index_entry(in, index_pos + 8 * i);
+        }
+        DCHECK_EQ(offsets[num_blocks], index_pos);
+
+        StatPhase::wrap("Decompress Blocks", [&]{
+            // allocations of the other threads are not tracked (see
+            // parallel::run), so the buffers are allocated here
+            std::vector<std::vector<uint8_t>> decoded(threads);
+            for(auto& block : decoded) block.reserve(block_size + 1);
+
+            // decompress up to one block per thread at a time
+            for(size_t first = 0; first < num_blocks; first += threads) {
+                const size_t wave = std::min(threads, num_blocks - first);
+
+                parallel::run(wave, [&](size_t tid){
+                    const size_t i = first + tid;
+                    Input block_in = Input::from_memory(
+                        in.slice(offsets[i], offsets[i+1]));
+
+                    decoded[tid].clear();
+                    Output out = Output::from_memory(decoded[tid]);
+                    auto block_outs = out.as_stream();
+                    decompress_text(block_in, block_outs);
+                });
+
+                // write the blocks without their sentinels
+                for(size_t tid = 0; tid < wave; ++tid) {
+                    DCHECK(!decoded[tid].empty() && decoded[tid].back() == 0);
+                    outs.write((const char*)decoded[tid].data(), decoded[tid].size() - 1);
+                }
+            }
+
+            StatPhase::log("blocks", num_blocks);
+            StatPhase::log("threads", threads);
+        });
+
+        outs.put(0); // sentinel
     }
 };
 
 }
-
@@ -2,6 +2,7 @@
 
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/compressors/lz78/LZ78Trie.hpp>
+#include <tudocomp/compressors/lz78/LZ78DictSize.hpp>
 #include <tudocomp/Range.hpp>
 
 #include <tudocomp_stat/StatPhase.hpp>
@@ -17,12 +18,19 @@ namespace tdc {
         class Decompressor {
             std::vector<lz78::factorid_t> indices;
             std::vector<uliteral_t> literals;
+            std::vector<uliteral_t> buffer;
 
             public:
+            /// Removes all factors, but keeps the allocated storage.
+            inline void clear() {
+                indices.clear();
+                literals.clear();
+            }
+
             inline void decompress(lz78::factorid_t index, uliteral_t literal, std::ostream& out) {
                 indices.push_back(index);
                 literals.push_back(literal);
-                std::vector<uliteral_t> buffer;
+                buffer.clear();
 
                 while(index != 0) {
                     buffer.push_back(literal);
@@ -45,22 +53,13 @@ class LZ78Compressor: public Compressor {
 private:
     using node_t = typename dict_t::node_t;
 
-    static inline lz78::factorid_t select_size(Env& env, string_ref name) {
-        auto& o = env.option(name);
-        if (o.as_string() == "inf") {
-            return 0;
-        } else {
-            return o.as_integer();
-        }
-    }
-
     /// Max dictionary size before reset
     const lz78::factorid_t m_dict_max_size {0};
 
 public:
     inline LZ78Compressor(Env&& env):
         Compressor(std::move(env)),
-        m_dict_max_size(env.option("dict_size").as_integer())
+        m_dict_max_size(lz78::select_size(this->env(), "dict_size"))
     {}
 
     inline static Meta meta() {
@@ -109,18 +108,18 @@ public:
                 coder.encode(static_cast<uliteral_t>(c), literal_r);
                 factor_count++;
                 stat_factor_count++;
-                parent = node = dict.get_rootnode(0); // return to the root
-                DCHECK_EQ(node.id(), 0);
-                DCHECK_EQ(parent.id(), 0);
                 DCHECK_EQ(factor_count+1, dict.size());
                 // dictionary's maximum size was reached
                 if(tdc_unlikely(dict.size() == m_dict_max_size)) { // if m_dict_max_size == 0 this will never happen
-                    DCHECK(false); // broken right now
+                    // the decoder resets after the same amount of factors
                     reset_dict();
-                    factor_count = 0; //coder.dictionary_reset();
+                    factor_count = 0;
                     stat_dictionary_resets++;
                     stat_dict_counter_at_last_reset = m_dict_max_size;
                 }
+                parent = node = dict.get_rootnode(0); // return to the root
+                DCHECK_EQ(node.id(), 0);
+                DCHECK_EQ(parent.id(), 0);
             } else { // traverse further
                 parent = node;
                 node = child;
@@ -155,6 +154,12 @@ public:
             const uliteral_t chr = decoder.template decode<uliteral_t>(literal_r);
             decomp.decompress(index, chr, out);
             factor_count++;
+
+            // reset in lockstep with the compressor's dictionary
+            if(tdc_unlikely(factor_count + 1 == m_dict_max_size)) {
+                decomp.clear();
+                factor_count = 0;
+            }
         }
 
         out.flush();
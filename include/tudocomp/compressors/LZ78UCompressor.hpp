@@ -11,6 +11,7 @@
 #include <tudocomp/compressors/lz78/LZ78Trie.hpp>
 
 #include "lz78u/SuffixTree.hpp"
+#include "lz78u/LCPIntervalTree.hpp"
 
 #include "lz78u/pre_header.hpp"
 
@@ -86,10 +87,14 @@ namespace lz78u {
     };
 }
 
-template<typename strategy_t, typename ref_coder_t>
+/// Computes the LZ78U factorization of the input using its suffix tree.
+///
+/// The suffix tree is provided by \c tree_t, which is either
+/// \ref lz78u::CSTSada or \ref lz78u::LCPIntervalTree.
+template<typename strategy_t, typename ref_coder_t, typename tree_t = lz78u::CSTSada>
 class LZ78UCompressor: public Compressor {
 private:
-    using node_type = lz78u::SuffixTree::node_type;
+    using node_t = typename tree_t::node_type;
 
     using RefEncoder = typename ref_coder_t::Encoder;
     using RefDecoder = typename ref_coder_t::Decoder;
@@ -108,6 +113,7 @@ public:
         Meta m("compressor", "lz78u", "Lempel-Ziv 78 U\n\n" );
         m.option("comp").templated<strategy_t>("lz78u_strategy");
         m.option("coder").templated<ref_coder_t>("coder");
+        m.option("tree").templated<tree_t, lz78u::CSTSada>("lz78u_tree");
         m.option("threshold").dynamic("3");
         // m.option("dict_size").dynamic("inf");
         m.input_restrictions(io::InputRestrictions({0},true));
@@ -123,25 +129,37 @@ public:
         auto iview = input.as_view();
         View T = iview;
 
-        lz78u::SuffixTree::cst_t backing_cst;
-        StatPhase::wrap("construct suffix tree", [&]{
-            // TODO: Specialize sdsl template for less alloc here
-            std::string bad_copy_1 = T.slice(0, T.size() - 1);
-            //std::cout << "text: " << vec_to_debug_string(bad_copy_1) << "\n";
+        const tree_t ST(env().env_for_option("tree"), T);
 
-            construct_im(backing_cst, bad_copy_1, 1);
-        });
-        lz78u::SuffixTree ST(backing_cst);
+        size_t sigma = 0;
+        {
+            std::vector<bool> occurs(ULITERAL_MAX + 1);
+            for(uliteral_t c : T) {
+                if(!occurs[c]) {
+                    occurs[c] = true;
+                    ++sigma;
+                }
+            }
+        }
 
-        const size_t max_z = T.size() * bits_for(ST.cst.csa.sigma) / bits_for(T.size());
+        const size_t max_z = T.size() * bits_for(sigma) / bits_for(T.size());
         phase1.log_stat("max z", max_z);
 
-        sdsl::int_vector<> R(ST.internal_nodes,0,bits_for(max_z));
+        DynamicIntVector R(ST.internal_nodes(), 0, bits_for(max_z));
 
         len_t pos = 0;
         len_t z = 0;
 
-        typedef lz78u::SuffixTree::node_type node_t;
+        // finds the deepest ancestor of the leaf l that is the root or has
+        // a factor id, and its child on the path to l
+        auto find_marked = [&](const node_t& l, node_t& parent, node_t& node) {
+            parent = ST.root();
+            node = ST.child(parent, l);
+            while(!ST.is_leaf(node) && R[ST.nid(node)] != 0) {
+                parent = node;
+                node = ST.child(node, l);
+            }
+        };
 
         CompressionStrat strategy {
             env().env_for_option("comp"),
@@ -171,14 +189,9 @@ public:
                 for(len_t pos = begin; pos < end;) {
                     // similar to the normal LZ78U factorization, but does not introduce new factor ids
 
-                    const node_t leaf = ST.select_leaf(ST.cst.csa.isa[pos]);
-                    len_t d = 1;
-                    node_t parent = ST.root;
-                    node_t node = ST.level_anc(leaf, d);
-                    while(!ST.cst.is_leaf(node) && R[ST.nid(node)] != 0) {
-                        parent = node;
-                        node = ST.level_anc(leaf, ++d);
-                    } // not a good feature: We lost the factor ids of the leaves, since R only stores the IDs of internal nodes
+                    node_t parent, node;
+                    find_marked(ST.leaf(pos), parent, node);
+                    // not a good feature: We lost the factor ids of the leaves, since R only stores the IDs of internal nodes
                     const len_t depth = ST.str_depth(parent);
                     // if the largest factor is not large enough, we only store the current character and move one text position to the right
                     if(depth < threshold) {
@@ -224,16 +237,18 @@ public:
 
         // Skip the trailing 0
         while(pos < T.size() - 1) {
-            const node_t l = ST.select_leaf(ST.cst.csa.isa[pos]);
             const len_t leaflabel = pos;
 
-            if(ST.parent(l) == ST.root || R[ST.nid(ST.parent(l))] != 0) {
-                const len_t parent_strdepth = ST.str_depth(ST.parent(l));
+            node_t parent, node;
+            find_marked(ST.leaf(pos), parent, node);
+
+            if(ST.is_leaf(node)) {
+                const len_t parent_strdepth = ST.str_depth(parent);
 
                 //std::cout << "out leaf: [" << (pos+parent_strdepth)  << ","<< (pos + parent_strdepth + 1) << "] ";
                 output(pos + parent_strdepth,
                        pos + parent_strdepth + 1,
-                       R[ST.nid(ST.parent(l))]);
+                       R[ST.nid(parent)]);
 
                 pos += parent_strdepth+1;
                 ++z;
@@ -243,15 +258,6 @@ public:
                 continue;
             }
 
-            len_t d = 1;
-            node_t parent = ST.root;
-            node_t node = ST.level_anc(l, d);
-
-
-            while(R[ST.nid(node)] != 0) {
-                parent = node;
-                node = ST.level_anc(l, ++d);
-            }
             pos += ST.str_depth(parent);
 
 
@@ -262,7 +268,7 @@ public:
             //std::cout << "out slice: [ "<< (leaflabel + ST.str_depth(parent)) << ", "<< (leaflabel + ST.str_depth(node))<< " ] ";
             output(begin,
                    end,
-                   R[ST.nid(ST.parent(node))]);
+                   R[ST.nid(parent)]);
             R[ST.nid(node)] = ++z;
 
             pos += end - begin;
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <algorithm>
-#include <functional>
 #include <vector>
 
 #include <tudocomp/Compressor.hpp>
@@ -19,7 +18,13 @@
 namespace tdc {
 
 /// Computes the LZ77 factorization of the input using its suffix array and
-/// LCP table.
+/// the previous and next smaller values in it.
+///
+/// The longest previous factor at a text position is shared with either of
+/// the suffixes preceding it in the text that are closest to it in the
+/// suffix array, i.e., its previous or next smaller value. Its length is
+/// computed by comparing the text, which takes linear time in total, since
+/// the compared characters are covered by the factors (see [KKP, 2013]).
 template<typename coder_t, typename text_t = TextDS<>>
 class LZSSLCPCompressor : public Compressor {
 public:
@@ -28,7 +33,7 @@ public:
         m.option("coder").templated<coder_t>("coder");
         m.option("textds").templated<text_t, TextDS<>>("textds");
         m.option("threshold").dynamic(3);
-        m.uses_textds<text_t>(text_t::SA | text_t::ISA | text_t::LCP);
+        m.uses_textds<text_t>(text_t::SA | text_t::ISA | text_t::PSV | text_t::NSV);
         return m;
     }
 
@@ -46,12 +51,13 @@ public:
         // Construct text data structures
         text_t text = StatPhase::wrap("Construct Text DS", [&]{
             return text_t(env().env_for_option("textds"), view,
-                    text_t::SA | text_t::ISA | text_t::LCP);
+                    text_t::SA | text_t::ISA | text_t::PSV | text_t::NSV);
         });
 
         auto& sa = text.require_sa();
         auto& isa = text.require_isa();
-        auto& lcp = text.require_lcp();
+        auto& psv = text.require_psv();
+        auto& nsv = text.require_nsv();
 
         // Factorize
         const len_t text_length = text.size();
@@ -60,49 +66,38 @@ public:
         StatPhase::wrap("Factorize", [&]{
             const len_t threshold = env().option("threshold").as_integer(); //factor threshold
 
+            // the length of the common prefix of the suffixes i and j,
+            // where j is the text length if there is no such suffix
+            auto lcp = [&](len_t i, len_t j) -> len_t {
+                if(j >= text_length) return 0;
+
+                // the suffixes differ at the latest at the \0 byte
+                len_t l = 0;
+                while(text[i + l] == text[j + l]) ++l;
+                return l;
+            };
+
             for(len_t i = 0; i+1 < text_length;) { // we omit T[text_length-1] since we assume that it is the \0 byte!
                 //get SA position for suffix i
-                const size_t& cur_pos = isa[i];
-			    DCHECK_NE(cur_pos,0); // isa[i] == 0 <=> T[i] = 0
-
-			    //compute naively PSV
-                //search "upwards" in LCP array
-                //include current, exclude last
-                size_t psv_lcp = lcp[cur_pos];
-                ssize_t psv_pos = cur_pos - 1;
-                if (psv_lcp > 0) {
-                    while (psv_pos >= 0 && sa[psv_pos] > sa[cur_pos]) {
-                        psv_lcp = std::min<size_t>(psv_lcp, lcp[psv_pos--]);
-                    }
-                }
+                const len_t cur_pos = isa[i];
+                DCHECK_NE(cur_pos,0); // isa[i] == 0 <=> T[i] = 0
 
-			    //compute naively NSV, TODO: use NSV data structure
-                //search "downwards" in LCP array
-                //exclude current, include last
-                size_t nsv_lcp = 0;
-                size_t nsv_pos = cur_pos + 1;
-                if (nsv_pos < text_length) {
-                    nsv_lcp = SSIZE_MAX;
-                    do {
-                        nsv_lcp = std::min<size_t>(nsv_lcp, lcp[nsv_pos]);
-                        if (sa[nsv_pos] < sa[cur_pos]) {
-                            break;
-                        }
-                    } while (++nsv_pos < text_length);
-
-                    if (nsv_pos >= text_length) {
-                        nsv_lcp = 0;
-                    }
-                }
+                //get the closest preceding suffixes in the SA
+                const len_t psv_pos = psv[cur_pos];
+                const len_t nsv_pos = nsv[cur_pos];
+                const len_t psv_src = (psv_pos < text_length) ? len_t(sa[psv_pos]) : text_length;
+                const len_t nsv_src = (nsv_pos < text_length) ? len_t(sa[nsv_pos]) : text_length;
+
+                const len_t psv_lcp = lcp(i, psv_src);
+                const len_t nsv_lcp = lcp(i, nsv_src);
 
                 //select maximum
-                const size_t& max_lcp = std::max(psv_lcp, nsv_lcp);
+                const len_t max_lcp = std::max(psv_lcp, nsv_lcp);
                 if(max_lcp >= threshold) {
-				    const ssize_t& max_pos = max_lcp == psv_lcp ? psv_pos : nsv_pos;
-				    DCHECK_LT(max_pos, text_length);
-				    DCHECK_GE(max_pos, 0);
+                    const len_t max_src = (max_lcp == psv_lcp) ? psv_src : nsv_src;
+                    DCHECK_LT(max_src, i);
                     // new factor
-                    factors.emplace_back(i, sa[max_pos], max_lcp);
+                    factors.emplace_back(i, max_src, max_lcp);
 
                     i += max_lcp; //advance
                 } else {
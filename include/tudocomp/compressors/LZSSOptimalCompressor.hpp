@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/Range.hpp>
+#include <tudocomp/util.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp/compressors/lzss/LZSSFactors.hpp>
+#include <tudocomp/compressors/lzss/LZSSLiterals.hpp>
+#include <tudocomp/compressors/lzss/LZSSCoding.hpp>
+
+#include <tudocomp/ds/TextDS.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Computes an LZ77 factorization of the input that minimizes the size of
+/// its encoding, using the input's suffix array and LCP table.
+///
+/// For each text position, the longest previous factor and one of its
+/// sources are computed from the previous and next smaller suffixes in the
+/// suffix array. Any prefix of at least \c threshold characters of such a
+/// factor is a candidate. The factorization is then chosen as a shortest
+/// path over the text positions, where literals and factors cost as many
+/// bits as their \ref Range "Ranges" take in \ref lzss::encode_text when
+/// encoded with their minimal bit widths.
+///
+/// Since the ranges of factor lengths and literal runs are only known
+/// after factorizing, the factorization is first computed with estimated
+/// ranges. It is then computed again with the ranges of the first
+/// factorization and with those of the greedy factorization. In these
+/// passes, the factor lengths and literal runs are bounded by the ranges,
+/// so the result is at most as large as the factorization they were taken
+/// from. The smallest factorization is encoded.
+///
+/// If a block size is given, the shortest paths are computed for blocks
+/// of that size independently and in parallel. Factors do not cross block
+/// boundaries, but may refer to any previous text position.
+template<typename coder_t, typename text_t = TextDS<>>
+class LZSSOptimalCompressor : public Compressor {
+private:
+    static constexpr size_t LITERAL_BITS = 8 * sizeof(uliteral_t);
+    static constexpr uint64_t INF = UINT64_MAX;
+
+    /// The bit costs of the encoding, and the bounds of the factor lengths
+    /// and literal runs they are valid for.
+    struct Costs {
+        size_t factor; // a factor, including the preceding bit
+        size_t run;    // the length of a run of literals
+
+        size_t min_len, max_len, max_run;
+
+        inline Costs(size_t n, size_t flen_delta, size_t fdist_max,
+                     size_t min_len, size_t max_len = SIZE_MAX,
+                     size_t max_run = SIZE_MAX)
+            : factor(1 + bits_for(n) + bits_for(flen_delta)),
+              run(bits_for(fdist_max)),
+              min_len(min_len), max_len(max_len), max_run(max_run) {
+        }
+    };
+
+    // the ranges of lzss::encode_text for the given factors
+    inline static Costs costs_of(size_t n, const lzss::FactorBuffer& factors,
+                                 size_t threshold = 1) {
+        size_t fdist_max = 0;
+        size_t p = 0;
+        for(size_t i = 0; i < factors.size(); i++) {
+            fdist_max = std::max(fdist_max, size_t(factors[i].pos - p));
+            p = factors[i].pos + factors[i].len;
+        }
+        fdist_max = std::max(fdist_max, n - p);
+
+        if(factors.empty()) return Costs(n, 0, fdist_max, threshold);
+
+        const size_t min_len = factors.shortest_factor();
+        const size_t max_len = factors.longest_factor();
+        return Costs(n, max_len - min_len, fdist_max, min_len, max_len, fdist_max);
+    }
+
+    /// Computes the shortest path over the positions [b, e) of a text
+    /// without its sentinel at position \c m.
+    ///
+    /// The path is computed backwards. \c g is the cost of the remaining
+    /// path from a position, where either a factor or a run of literals
+    /// followed by a factor starts, \c f the cost if a factor starts.
+    /// For each position, the chosen factor length is stored in \c len and
+    /// the length of the run, if the path starts with one, in \c run_len.
+    ///
+    /// Since the right ends of the candidate factors are non-decreasing in
+    /// text order, the cheapest factor end is maintained in a monotone
+    /// queue. Likewise, the cheapest end of a run, which is bounded by the
+    /// maximum run length, is maintained in a second one.
+    inline static void shortest_path(
+        size_t b, size_t e, size_t m, const Costs& c,
+        std::vector<len_t>& len, std::vector<uint64_t>& g,
+        std::vector<len_t>& run_len) {
+
+        // g at position e belongs to the next block, or is the run of the
+        // sentinel at the end of the text
+        const uint64_t g_e = (e == m) ? c.run : 0;
+        auto g_at = [&](size_t p) { return (p == e) ? g_e : g[p]; };
+
+        std::deque<size_t> ends; // increasing positions, decreasing costs
+
+        // run ends j with the cost LITERAL_BITS * j + f(j), a run that
+        // ends the text also contains the sentinel
+        struct run_end_t { size_t pos, limit; uint64_t cost; };
+        std::deque<run_end_t> run_ends; // increasing positions, decreasing costs
+        run_ends.push_front(run_end_t { e, (e == m) ? e + 1 : e, LITERAL_BITS * e });
+
+        for(size_t i = e; i-- > b;) {
+            // candidate factor ends are [i + min_len, min(i + len[i], e)]
+            const size_t right = std::min(i + std::min(size_t(len[i]), c.max_len), e);
+            if(i + c.min_len <= e) {
+                const size_t p = i + c.min_len;
+                while(!ends.empty() && g_at(ends.front()) > g_at(p)) ends.pop_front();
+                ends.push_front(p);
+            }
+            while(!ends.empty() && ends.back() > right) ends.pop_back();
+
+            uint64_t f = INF;
+            len[i] = 0;
+            if(!ends.empty() && g_at(ends.back()) != INF) {
+                f = c.factor + g_at(ends.back());
+                len[i] = ends.back() - i;
+            }
+
+            // candidate run ends are [i + 1, i + max_run]
+            while(!run_ends.empty() && run_ends.back().limit - i > c.max_run) {
+                run_ends.pop_back();
+            }
+
+            uint64_t lit = INF;
+            if(!run_ends.empty()) {
+                lit = c.run + run_ends.back().cost - LITERAL_BITS * i;
+            }
+
+            if(lit <= f && lit != INF) {
+                g[i] = lit;
+                run_len[i] = run_ends.back().pos - i;
+            } else {
+                g[i] = f;
+                run_len[i] = 0;
+            }
+
+            if(f != INF) {
+                const uint64_t cost = LITERAL_BITS * i + f;
+                while(!run_ends.empty() && run_ends.front().cost >= cost) run_ends.pop_front();
+                run_ends.push_front(run_end_t { i, i, cost });
+            }
+        }
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("compressor", "lzss_optimal", "LZSS Factorization using optimal parsing");
+        m.option("coder").templated<coder_t>("coder");
+        m.option("textds").templated<text_t, TextDS<>>("textds");
+        m.option("threshold").dynamic(2);
+        m.option("block_size").dynamic(0);
+        m.option("threads").dynamic(0);
+        m.uses_textds<text_t>(text_t::SA | text_t::LCP);
+        return m;
+    }
+
+    /// Default constructor (not supported).
+    inline LZSSOptimalCompressor() = delete;
+
+    /// Construct the class with an environment.
+    inline LZSSOptimalCompressor(Env&& env) : Compressor(std::move(env)) {
+    }
+
+    /// \brief Returns the size of the encoding of a factorization in bits,
+    ///        except for the constant header.
+    ///
+    /// \param n The length of the text, including the sentinel.
+    /// \param factors The factors.
+    inline static size_t size_of(size_t n, const lzss::FactorBuffer& factors) {
+        const Costs c = costs_of(n, factors);
+
+        size_t bits = 0;
+        size_t p = 0;
+        for(size_t i = 0; i < factors.size(); i++) {
+            const size_t lits = factors[i].pos - p;
+            bits += c.factor + ((lits > 0) ? c.run + lits * LITERAL_BITS : 0);
+            p = factors[i].pos + factors[i].len;
+        }
+        if(p < n) bits += 1 + c.run + (n - p) * LITERAL_BITS;
+        return bits;
+    }
+
+    /// \brief Computes the shortest path and the greedy factorization of a
+    ///        text.
+    ///
+    /// \param text The text data structures, which provide the suffix array
+    ///             and the LCP table.
+    /// \param path Receives the smaller of the shortest paths computed with
+    ///             the estimated and the refined ranges.
+    /// \param greedy Receives the greedy factorization.
+    inline void factorize(text_t& text,
+        lzss::FactorBuffer& path, lzss::FactorBuffer& greedy) {
+
+        const len_t n = text.size();
+        const len_t m = n - 1; // we omit the \0 byte, which stays a literal
+
+        // the longest previous factor and its source for each position
+        std::vector<len_t> lpf(n, 0);
+        std::vector<len_t> src(n, 0);
+
+        StatPhase::wrap("Compute Candidates", [&]{
+            auto& sa = text.require_sa();
+            auto& lcp = text.require_lcp();
+
+            // stack of suffix array positions with increasing text
+            // positions, each with the minimum LCP value between it and the
+            // next position on the stack (or the current position)
+            struct entry_t { len_t k, lcp; };
+            std::vector<entry_t> stack;
+
+            for(len_t k = 0; k < n; k++) {
+                const len_t i = sa[k];
+                if(!stack.empty()) {
+                    stack.back().lcp = std::min(stack.back().lcp, len_t(lcp[k]));
+                }
+
+                // k is the next smaller value of the popped positions
+                while(!stack.empty() && len_t(sa[stack.back().k]) > i) {
+                    const entry_t top = stack.back();
+                    stack.pop_back();
+
+                    const len_t j = sa[top.k];
+                    if(top.lcp > lpf[j]) {
+                        lpf[j] = top.lcp;
+                        src[j] = i;
+                    }
+
+                    if(!stack.empty()) {
+                        stack.back().lcp = std::min(stack.back().lcp, top.lcp);
+                    }
+                }
+
+                // the top is the previous smaller value of k
+                if(!stack.empty() && stack.back().lcp > 0) {
+                    lpf[i] = stack.back().lcp;
+                    src[i] = sa[stack.back().k];
+                }
+
+                stack.push_back(entry_t { k, len_t(-1) });
+            }
+        });
+
+        const size_t threshold = std::max(size_t(1),
+            size_t(env().option("threshold").as_integer()));
+        const size_t block_size = env().option("block_size").as_integer();
+        const size_t threads = parallel::num_threads(
+            env().option("threads").as_integer());
+
+        // computes the factorization using the given costs
+        std::vector<len_t> len(m);
+        std::vector<uint64_t> g(m);
+        std::vector<len_t> run_len(m);
+
+        // returns false if the bounds of the costs cannot be met
+        auto shortest_paths = [&](const Costs& c, lzss::FactorBuffer& factors) {
+            std::copy(lpf.begin(), lpf.begin() + m, len.begin());
+
+            const size_t bs = (block_size > 0) ? block_size : std::max(size_t(m), size_t(1));
+            const size_t num_blocks = idiv_ceil(m, bs);
+
+            for(size_t first = 0; first < num_blocks; first += threads) {
+                const size_t wave = std::min(threads, num_blocks - first);
+                parallel::run(wave, [&](size_t tid){
+                    const size_t b = (first + tid) * bs;
+                    shortest_path(b, std::min(size_t(m), b + bs), m, c, len, g, run_len);
+                });
+            }
+
+            for(size_t b = 0; b < m; b += bs) {
+                if(g[b] == INF) return false;
+            }
+
+            // follow the paths, a run is followed by a factor
+            for(size_t i = 0; i < m;) {
+                const size_t e = std::min(size_t(m), (i / bs + 1) * bs);
+                i += run_len[i];
+                if(i < e) {
+                    factors.emplace_back(i, src[i], len[i]);
+                    i += len[i];
+                }
+            }
+            return true;
+        };
+
+        StatPhase::wrap("Factorize", [&]{
+            // estimate the ranges: factors are at most as long as the
+            // longest previous factor, and literal runs are at least as
+            // long as the longest run of positions without a candidate
+            size_t flen_max = 0, run_max = 0;
+            for(size_t i = 0, run = 0; i < m; i++) {
+                flen_max = std::max(flen_max, size_t(lpf[i]));
+                run = (lpf[i] < threshold) ? run + 1 : 0;
+                run_max = std::max(run_max, run);
+            }
+
+            shortest_paths(Costs(n, (flen_max > threshold) ? flen_max - threshold : 0,
+                                 run_max, threshold), path);
+
+            for(size_t i = 0; i < m;) {
+                if(lpf[i] >= threshold) {
+                    greedy.emplace_back(i, src[i], lpf[i]);
+                    i += lpf[i];
+                } else {
+                    ++i;
+                }
+            }
+
+            // factorize again within the ranges of the first and the
+            // greedy factorization, keep the smallest one
+            auto refine = [&](const Costs& c) {
+                lzss::FactorBuffer refined;
+                if(shortest_paths(c, refined) && size_of(n, refined) < size_of(n, path)) {
+                    path = std::move(refined);
+                }
+            };
+            refine(costs_of(n, path, threshold));
+            refine(costs_of(n, greedy, threshold));
+
+            StatPhase::log("threshold", threshold);
+        });
+    }
+
+    inline virtual void compress(Input& input, Output& output) override {
+        auto view = input.as_view();
+        DCHECK(view.ends_with(uint8_t(0)));
+
+        // Construct text data structures
+        text_t text = StatPhase::wrap("Construct Text DS", [&]{
+            return text_t(env().env_for_option("textds"), view,
+                    text_t::SA | text_t::LCP);
+        });
+
+        // the greedy factorization can only be smaller if the blocks do
+        // not admit its bounds
+        lzss::FactorBuffer factors, greedy;
+        factorize(text, factors, greedy);
+        if(size_of(text.size(), greedy) < size_of(text.size(), factors)) {
+            factors = std::move(greedy);
+        }
+        StatPhase::log("factors", factors.size());
+
+        // encode
+        typename coder_t::Encoder coder(env().env_for_option("coder"),
+            output, lzss::TextLiterals<text_t>(text, factors));
+
+        lzss::encode_text(coder, text, factors);
+    }
+
+    inline virtual void decompress(Input& input, Output& output) override {
+        typename coder_t::Decoder decoder(env().env_for_option("coder"), input);
+        auto outs = output.as_stream();
+
+        lzss::decode_text<typename coder_t::Decoder, lzss::DecodeBackBuffer>(decoder, outs);
+    }
+};
+
+}
@@ -4,6 +4,7 @@
 #include <tudocomp/Literal.hpp>
 #include <tudocomp/Range.hpp>
 #include <tudocomp/util.hpp>
+#include <tudocomp/compressors/lzss/LZSSSlidingWindow.hpp>
 
 #include <tudocomp_stat/StatPhase.hpp>
 
@@ -11,6 +12,10 @@ namespace tdc {
 
 /// Computes the LZ77 factorization of the input by moving a sliding window
 /// over it in which redundant phrases will be looked for.
+///
+/// The window is searched using hash chains, of which at most \c max_chain
+/// positions are compared for each factor. The search stops early once a
+/// factor of length \c nice_len has been found.
 template<typename coder_t>
 class LZSSSlidingWindowCompressor : public Compressor {
 
@@ -23,6 +28,8 @@ public:
         m.option("coder").templated<coder_t>("coder");
         m.option("window").dynamic(16);
         m.option("threshold").dynamic(3);
+        m.option("max_chain").dynamic(32);
+        m.option("nice_len").dynamic(64);
         return m;
     }
 
@@ -33,6 +40,7 @@ public:
     inline LZSSSlidingWindowCompressor(Env&& e) : Compressor(std::move(e))
     {
         m_window = this->env().option("window").as_integer();
+        if(m_window == 0) this->env().error("window must be positive");
     }
 
     /// \copydoc
@@ -41,48 +49,34 @@ public:
 
         typename coder_t::Encoder coder(env().env_for_option("coder"), output, NoLiterals());
 
-        std::vector<uint8_t> buf;
-
-        size_t ahead = 0; //marks the index in the buffer at which the back buffer ends and the ahead buffer begins
-        char c;
-
         StatPhase phase("Factorize");
 
-        //initially fill the buffer
-        size_t buf_off = 0;
-        while(buf.size() < 2 * m_window && ins.get(c)) {
-            buf.push_back(uint8_t(c));
-        }
-
         //factorize
         const len_t threshold = env().option("threshold").as_integer(); //factor threshold
         phase.log_stat("threshold", threshold);
 
-        size_t pos = 0;
-        bool eof = false;
-        while(ahead < buf.size()) {
-            size_t fpos = 0, fsrc = 0, fnum = 0;
-
-            //walk back buffer
-            for(size_t k = (ahead > m_window ? ahead - m_window : 0); k < ahead; k++) {
-                //compare string
-                size_t j = 0;
-                while(ahead + j < buf.size() && buf[k + j] == buf[ahead + j]) {
-                    ++j;
-                }
+        lzss::SlidingWindow window(
+            m_window, m_window, threshold,
+            env().option("max_chain").as_integer(),
+            env().option("nice_len").as_integer());
 
-                //factorize if longer than one already found
-                if(j >= threshold && j > fnum) {
-                    fpos = buf_off + ahead;
-                    fsrc = buf_off + k;
-                    fnum = j;
-                }
+        char c;
+        while(true) {
+            //fill the ahead buffer
+            while(window.can_push() && ins.get(c)) {
+                window.push(uint8_t(c));
             }
+            if(window.lookahead() == 0) break;
+
+            //find longest factor
+            size_t fsrc = 0;
+            size_t fnum = window.find(fsrc);
+            const size_t fpos = window.pos();
 
             //output longest factor or symbol
             size_t advance;
 
-            if(fnum > 0) {
+            if(fnum > 0 && fnum >= threshold) {
                 // encode factor
                 coder.encode(true, bit_r);
                 coder.encode(fpos - fsrc, Range(fpos)); //delta
@@ -92,28 +86,12 @@ public:
             } else {
                 // encode literal
                 coder.encode(false, bit_r);
-                coder.encode(uliteral_t(buf[ahead]), literal_r);
+                coder.encode(window.current(), literal_r);
 
                 advance = 1;
             }
 
-            //advance buffer
-            pos += advance;
-            while(advance--) {
-                if(ahead < m_window) {
-                    //case 1: still reading the first w symbols from the stream
-                    ++ahead;
-                } else if(!eof && ins.get(c)) {
-                    //case 2: read a new symbol
-                    buf.erase(buf.begin()); //TODO ouch
-                    buf.push_back(uint8_t(c));
-                    ++buf_off;
-                } else {
-                    //case 3: EOF, read rest of buffer
-                    eof = true;
-                    ++ahead;
-                }
-            }
+            window.advance(advance);
         }
     }
 
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/Literal.hpp>
+#include <tudocomp/Range.hpp>
+#include <tudocomp/util.hpp>
+
+#include <tudocomp/ds/TextDS.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Computes an LZ77 factorization of the input in blocks, using text data
+/// structures of a bounded size.
+///
+/// The input is read in blocks of \c block_size literals. Each block is
+/// factorized like in \ref LZSSLCPCompressor, using the suffix array and
+/// its previous and next smaller values over the block preceded by the
+/// last \c window literals of the input. Hence, factors refer to at most
+/// <tt>window + block_size</tt> literals back and do not cross block
+/// boundaries.
+///
+/// Factors and literals are encoded as soon as their block is factorized.
+/// Note that only the memory of the factorization is bounded: an \ref Input
+/// constructed from a stream is still buffered in memory completely.
+///
+/// The text data structures are rebuilt for each block, so the
+/// factorization takes about <tt>(window + block_size) / block_size</tt>
+/// times as long as that of \ref LZSSLCPCompressor. Hence, the block size
+/// should not be much smaller than the window.
+template<typename coder_t, typename text_t = TextDS<>>
+class LZSSStreamCompressor : public Compressor {
+private:
+    size_t m_window;
+    size_t m_block_size;
+
+    // the maximum distance of a factor at the given text position
+    inline size_t max_distance(size_t pos) const {
+        return std::min(pos, m_window + m_block_size);
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("compressor", "lzss_stream", "LZSS Factorization of a stream using LCP");
+        m.option("coder").templated<coder_t>("coder");
+        m.option("textds").templated<text_t, TextDS<>>("textds");
+        m.option("window").dynamic(1048576);
+        m.option("block_size").dynamic(1048576);
+        m.option("threshold").dynamic(3);
+        m.uses_textds<text_t>(text_t::SA | text_t::ISA | text_t::PSV | text_t::NSV);
+        return m;
+    }
+
+    /// Default constructor (not supported).
+    inline LZSSStreamCompressor() = delete;
+
+    /// Construct the class with an environment.
+    inline LZSSStreamCompressor(Env&& e) : Compressor(std::move(e)) {
+        m_window = this->env().option("window").as_integer();
+        m_block_size = this->env().option("block_size").as_integer();
+        CHECK_GT(m_block_size, 0U) << "block_size must be positive";
+    }
+
+    inline virtual void compress(Input& input, Output& output) override {
+        auto ins = input.as_stream();
+
+        typename coder_t::Encoder coder(env().env_for_option("coder"), output, NoLiterals());
+
+        StatPhase phase("Factorize");
+
+        const len_t threshold = std::max(len_t(1),
+            len_t(env().option("threshold").as_integer())); //factor threshold
+        phase.log_stat("threshold", threshold);
+
+        // the history followed by the current block
+        std::vector<uliteral_t> buffer;
+        size_t offset = 0; // the text position of buffer[0]
+
+        size_t num_blocks = 0;
+        size_t num_factors = 0;
+
+        char c;
+        while(true) {
+            // keep the last m_window literals as history
+            if(buffer.size() > m_window) {
+                const size_t drop = buffer.size() - m_window;
+                buffer.erase(buffer.begin(), buffer.begin() + drop);
+                offset += drop;
+            }
+
+            const len_t begin = buffer.size();
+            for(size_t i = 0; i < m_block_size && ins.get(c); i++) {
+                buffer.push_back(uliteral_t(c));
+            }
+            const len_t end = buffer.size();
+            if(end == begin) break;
+            ++num_blocks;
+
+            // the last block already ends with the sentinel
+            const bool terminated = (buffer.back() == 0);
+            if(!terminated) buffer.push_back(0);
+
+            {
+                text_t text(env().env_for_option("textds"), View(buffer),
+                    text_t::SA | text_t::ISA | text_t::PSV | text_t::NSV);
+
+                auto& sa = text.require_sa();
+                auto& isa = text.require_isa();
+                auto& psv = text.require_psv();
+                auto& nsv = text.require_nsv();
+
+                const len_t n = text.size();
+
+                // the length of the common prefix of the suffixes i and j,
+                // where j is the buffer size if there is no such suffix
+                auto lcp = [&](len_t i, len_t j) -> len_t {
+                    if(j >= n) return 0;
+
+                    const len_t max = n - 1 - i; // exclude the sentinel
+                    len_t l = 0;
+                    while(l < max && buffer[i + l] == buffer[j + l]) ++l;
+                    return l;
+                };
+
+                for(len_t i = begin; i < end;) {
+                    const len_t cur_pos = isa[i];
+
+                    const len_t psv_pos = psv[cur_pos];
+                    const len_t nsv_pos = nsv[cur_pos];
+                    const len_t psv_src = (psv_pos < n) ? len_t(sa[psv_pos]) : n;
+                    const len_t nsv_src = (nsv_pos < n) ? len_t(sa[nsv_pos]) : n;
+
+                    const len_t psv_lcp = lcp(i, psv_src);
+                    const len_t nsv_lcp = lcp(i, nsv_src);
+
+                    const size_t fpos = offset + i;
+                    const len_t flen = std::max(psv_lcp, nsv_lcp);
+                    if(flen >= threshold) {
+                        const len_t fsrc = (flen == psv_lcp) ? psv_src : nsv_src;
+                        DCHECK_LT(fsrc, i);
+
+                        // encode factor
+                        coder.encode(true, bit_r);
+                        coder.encode(i - fsrc, Range(1, max_distance(fpos)));
+                        coder.encode(flen, Range(threshold, m_block_size));
+
+                        ++num_factors;
+                        i += flen;
+                    } else {
+                        // encode literal
+                        coder.encode(false, bit_r);
+                        coder.encode(buffer[i], literal_r);
+
+                        ++i;
+                    }
+                }
+            }
+
+            if(!terminated) buffer.pop_back();
+        }
+
+        phase.log_stat("blocks", num_blocks);
+        phase.log_stat("factors", num_factors);
+    }
+
+    inline virtual void decompress(Input& input, Output& output) override {
+        typename coder_t::Decoder decoder(env().env_for_option("coder"), input);
+        auto outs = output.as_stream();
+
+        const len_t threshold = std::max(len_t(1),
+            len_t(env().option("threshold").as_integer()));
+        const size_t history = m_window + m_block_size;
+
+        // the decoded text, of which at least the last history literals
+        // are kept
+        std::vector<uliteral_t> buffer;
+        size_t offset = 0; // the text position of buffer[0]
+
+        while(!decoder.eof()) {
+            const size_t pos = offset + buffer.size();
+
+            bool is_factor = decoder.template decode<bool>(bit_r);
+            if(is_factor) {
+                const size_t fsrc = buffer.size() -
+                    decoder.template decode<size_t>(Range(1, max_distance(pos)));
+                const size_t flen =
+                    decoder.template decode<size_t>(Range(threshold, m_block_size));
+
+                for(size_t i = 0; i < flen; i++) {
+                    const uliteral_t c = buffer[fsrc + i];
+                    buffer.push_back(c);
+                    outs << c;
+                }
+            } else {
+                const uliteral_t c = decoder.template decode<uliteral_t>(literal_r);
+                buffer.push_back(c);
+                outs << c;
+            }
+
+            if(buffer.size() >= 2 * history) {
+                const size_t drop = buffer.size() - history;
+                buffer.erase(buffer.begin(), buffer.begin() + drop);
+                offset += drop;
+            }
+        }
+    }
+};
+
+} //ns
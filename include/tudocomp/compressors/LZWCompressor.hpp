@@ -2,6 +2,7 @@
 
 #include <tudocomp/Compressor.hpp>
 
+#include <tudocomp/compressors/lz78/LZ78DictSize.hpp>
 #include <tudocomp/compressors/lzw/LZWDecoding.hpp>
 #include <tudocomp/compressors/lzw/LZWFactor.hpp>
 
@@ -26,14 +27,20 @@ private:
 public:
     inline LZWCompressor(Env&& env):
         Compressor(std::move(env)),
-        m_dict_max_size(env.option("dict_size").as_integer())
-    {}
+        m_dict_max_size(lz78::select_size(this->env(), "dict_size"))
+    {
+        // the dictionary starts with a root node for every literal
+        if(m_dict_max_size != 0 && m_dict_max_size <= ULITERAL_MAX + 1) {
+            this->env().error("dict_size must be larger than the alphabet size "
+                + std::to_string(ULITERAL_MAX + 1));
+        }
+    }
 
     inline static Meta meta() {
         Meta m("compressor", "lzw", "Lempel-Ziv-Welch\n\n" LZ78_DICT_SIZE_DESC);
         m.option("coder").templated<coder_t, BitCoder>("coder");
         m.option("lz78trie").templated<dict_t, lz78::TernaryTrie>("lz78trie");
-        m.option("dict_size").dynamic(0);
+        m.option("dict_size").dynamic("inf");
         return m;
     }
 
@@ -51,12 +58,10 @@ public:
         dict_t dict(env().env_for_option("lz78trie"), reserved_size);
 		auto reset_dict = [&dict] () {
 			dict.clear();
-            std::stringstream ss;
 			for(size_t i = 0; i < ULITERAL_MAX+1; ++i) {
 				const node_t node = dict.add_rootnode(i);
 				DCHECK_EQ(node.id(), dict.size() - 1);
                 DCHECK_EQ(node.id(), i);
-                ss << node.id() << ", ";
 			}
 		};
 		reset_dict();
@@ -77,15 +82,15 @@ public:
                 stat_factor_count++;
                 factor_count++;
 				DCHECK_EQ(factor_count+ULITERAL_MAX+1, dict.size());
-                node = dict.get_rootnode(static_cast<uliteral_t>(c));
 				// dictionary's maximum size was reached
-				if(dict.size() == m_dict_max_size) {
-					DCHECK_GT(dict.size(),0);
+				if(tdc_unlikely(dict.size() == m_dict_max_size)) {
+					// the decoder resets after the same amount of factors
 					reset_dict();
-					factor_count = 0; //coder.dictionary_reset();
+					factor_count = 0;
 					stat_dictionary_resets++;
 					stat_dict_counter_at_last_reset = m_dict_max_size;
 				}
+                node = dict.get_rootnode(static_cast<uliteral_t>(c));
 			} else { // traverse further
 				node = child;
 			}
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 #include <tudocomp/Compressor.hpp>
 
 #include <tudocomp/Range.hpp>
@@ -83,6 +89,229 @@ private:
         }
     };
 
+    /// \brief Maintains the occurrences and frequencies of all digrams in
+    ///        the text while they are being replaced (see [Larsson and
+    ///        Moffat, 2000]).
+    ///
+    /// The occurrences of each digram are kept in a doubly linked list in
+    /// text order, and the digrams are kept in a priority queue of buckets by
+    /// frequency. Replacing an occurrence only affects the counts of the
+    /// digrams overlapping it, so a grammar is computed in linear time.
+    ///
+    /// Overlapping occurrences of a digram \c aa are only counted once.
+    class DigramIndex {
+    private:
+        static constexpr len_t NONE = std::numeric_limits<len_t>::max();
+
+        struct Record {
+            digram_t di;
+            len_t count;
+            len_t head, tail; // occurrence list
+            len_t prev, next; // bucket list
+        };
+
+        struct Position {
+            len_t prev;     // previous position in the text
+            len_t occ_prev; // previous occurrence of the digram
+            len_t occ_next; // next occurrence of the digram
+            len_t record;   // the digram's record, or NONE if not linked
+        };
+
+        sym_t* m_text;
+        len_t* m_next;
+        len_t  m_n;
+
+        std::vector<Position> m_pos;
+
+        std::vector<Record> m_records;
+        std::unordered_map<digram_t, len_t> m_index;
+        std::vector<len_t> m_free;
+
+        // m_buckets[c] lists the digrams occurring c times, except for the
+        // last bucket, which lists all digrams occurring at least as often
+        std::vector<len_t> m_buckets;
+        size_t m_top;
+
+        inline size_t bucket(len_t count) const {
+            return std::min(size_t(count), m_buckets.size() - 1);
+        }
+
+        inline void pq_insert(len_t r) {
+            Record& rec = m_records[r];
+            if(rec.count < 2) return;
+
+            len_t& head = m_buckets[bucket(rec.count)];
+            rec.prev = NONE;
+            rec.next = head;
+            if(head != NONE) m_records[head].prev = r;
+            head = r;
+        }
+
+        inline void pq_remove(len_t r) {
+            Record& rec = m_records[r];
+            if(rec.count < 2) return;
+
+            if(rec.prev != NONE) m_records[rec.prev].next = rec.next;
+            else m_buckets[bucket(rec.count)] = rec.next;
+            if(rec.next != NONE) m_records[rec.next].prev = rec.prev;
+        }
+
+        inline len_t get_record(digram_t di) {
+            auto it = m_index.find(di);
+            if(it != m_index.end()) return it->second;
+
+            len_t r;
+            if(m_free.empty()) {
+                r = m_records.size();
+                m_records.emplace_back();
+            } else {
+                r = m_free.back();
+                m_free.pop_back();
+            }
+            m_records[r] = Record { di, 0, NONE, NONE, NONE, NONE };
+            m_index.emplace(di, r);
+            return r;
+        }
+
+        inline void release_record(len_t r) {
+            m_index.erase(m_records[r].di);
+            m_free.push_back(r);
+        }
+
+        // links the occurrence of the digram starting at position i
+        inline void link(len_t i) {
+            if(m_next[i] >= m_n) return; // end of text
+
+            const sym_t a = m_text[i];
+            const sym_t b = m_text[m_next[i]];
+            if(a == b) {
+                // do not count overlapping occurrences
+                const len_t p = m_pos[i].prev;
+                if(p != NONE && m_pos[p].record != NONE && m_text[p] == a) return;
+            }
+
+            const len_t r = get_record(digram(a, b));
+            Record& rec = m_records[r];
+            Position& pos = m_pos[i];
+
+            pos.record = r;
+            pos.occ_prev = rec.tail;
+            pos.occ_next = NONE;
+            if(rec.tail != NONE) m_pos[rec.tail].occ_next = i;
+            else rec.head = i;
+            rec.tail = i;
+
+            pq_remove(r);
+            ++rec.count;
+            pq_insert(r);
+        }
+
+        // unlinks the occurrence of the digram starting at position i
+        inline void unlink(len_t i) {
+            Position& pos = m_pos[i];
+            const len_t r = pos.record;
+            if(r == NONE) return;
+
+            Record& rec = m_records[r];
+            if(pos.occ_prev != NONE) m_pos[pos.occ_prev].occ_next = pos.occ_next;
+            else rec.head = pos.occ_next;
+            if(pos.occ_next != NONE) m_pos[pos.occ_next].occ_prev = pos.occ_prev;
+            else rec.tail = pos.occ_prev;
+            pos.record = NONE;
+
+            pq_remove(r);
+            if(--rec.count == 0) {
+                release_record(r); // the digram does not occur anymore
+            } else {
+                pq_insert(r);
+            }
+        }
+
+        // replaces the digram starting at position i by symbol x
+        inline void replace(len_t i, sym_t x) {
+            const len_t p = m_pos[i].prev;
+            const len_t j = m_next[i];
+            const len_t q = m_next[j];
+
+            // remove the digrams overlapping the replaced one
+            if(p != NONE) unlink(p);
+            if(q < m_n) unlink(j);
+
+            m_text[i] = x;
+            m_next[i] = q;
+            if(q < m_n) m_pos[q].prev = i;
+
+            // add the new digrams
+            if(p != NONE) link(p);
+            link(i);
+        }
+
+        // removes and returns the most frequent digram, or NONE
+        inline len_t pop_max() {
+            for(; m_top >= 2; --m_top) {
+                len_t r = m_buckets[m_top];
+                if(r == NONE) continue;
+
+                if(m_top == m_buckets.size() - 1) {
+                    // the last bucket is not sorted
+                    for(len_t s = r; s != NONE; s = m_records[s].next) {
+                        if(m_records[s].count > m_records[r].count) r = s;
+                    }
+                }
+
+                pq_remove(r);
+                return r;
+            }
+            return NONE;
+        }
+
+    public:
+        /// Indexes the digrams of the text given by the symbols and the
+        /// positions of the successor of each symbol.
+        inline DigramIndex(sym_t* text, len_t* next, len_t n)
+            : m_text(text), m_next(next), m_n(n), m_pos(n),
+              m_buckets(std::max(size_t(std::sqrt(double(n))), size_t(2)) + 1,
+                        len_t(NONE)),
+              m_top(m_buckets.size() - 1) {
+
+            for(len_t i = 0; i < n; i++) {
+                m_pos[i].prev = (i > 0) ? i - 1 : len_t(NONE);
+                m_pos[i].record = NONE;
+            }
+
+            for(len_t i = 0; i < n; i++) link(i);
+        }
+
+        /// Replaces the most frequent digram of the text by a new rule, as
+        /// long as there is a digram occurring more than once.
+        ///
+        /// \return The amount of replaced occurrences, or zero if no digram
+        ///         occurs more than once.
+        inline size_t replace_max(grammar_t& grammar) {
+            const len_t r = pop_max();
+            if(r == NONE) return 0;
+
+            // the record is not touched by the replacements, because
+            // linked occurrences do not overlap
+            const sym_t x = sigma + grammar.size();
+            grammar.push_back(m_records[r].di);
+
+            size_t num_replaced = 0;
+            for(len_t i = m_records[r].head; i != NONE;) {
+                const len_t next = m_pos[i].occ_next;
+                m_pos[i].record = NONE;
+
+                replace(i, x);
+                ++num_replaced;
+
+                i = next;
+            }
+
+            release_record(r);
+            return num_replaced;
+        }
+    };
+
 public:
     inline static Meta meta() {
         Meta m("compressor", "repair", "Re-Pair compression");
@@ -120,62 +349,15 @@ public:
 
         size_t num_replaced = 0;
 
-        do {
-            // count digrams
-            digram_t max;
-            size_t max_count = 0;
-
-            {
-                std::unordered_map<digram_t, size_t> count;
-                // TODO: probably not optimal, but twice as fast as std::map
-
-                size_t i = 0;
-                while(i < n - 1) {
-                    size_t j = next[i];
-                    if(j >= n) break; // break if at end
-
-                    digram_t di = digram(text[i], text[j]);
-
-                    // update counter
-                    size_t c = count[di] + 1;
-                    count[di] = c;
-
-                    // update max
-                    if(c > max_count) {
-                        max = di;
-                        max_count = c;
-                    }
-
-                    // advance
-                    i = j;
-                }
-            }
-
-            // replace most common digram (max)
-            if(max_count > 1) {
-                sym_t new_sym = sigma + grammar.size();
-                grammar.push_back(max);
-
-                size_t i = 0;
-                while(i < n - 1) {
-                    size_t j = next[i];
-                    if(j >= n) break; // break if at end
-
-                    digram_t di = digram(text[i], text[j]);
-                    if(di == max) {
-                        text[i] = new_sym; // replace symbol at i by new symbol
-                        next[i] = next[j];
-
-                        ++num_replaced;
-                    }
+        {
+            DigramIndex digrams(text, next, n);
+            while(grammar.size() < max_rules) {
+                const size_t k = digrams.replace_max(grammar);
+                if(k == 0) break; // done
 
-                    // advance
-                    i = next[i];
-                }
-            } else {
-                break; // done
+                num_replaced += k;
             }
-        } while(grammar.size() < max_rules);
+        }
 
         // debug
         /*
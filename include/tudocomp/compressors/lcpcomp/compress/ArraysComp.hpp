@@ -20,9 +20,6 @@ namespace lcpcomp {
  * In the latter case, we push it down to the respective array
  */
 class ArraysComp : public Algorithm {
-private:
-    typedef TextDS<> text_t;
-
 public:
     inline static Meta meta() {
         Meta m("lcpcomp_comp", "arrays");
@@ -30,11 +27,12 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA | text_t::LCP;
+        return ds::SA | ds::ISA | ds::LCP;
     }
 
     using Algorithm::Algorithm; //import constructor
 
+    template<typename text_t>
     inline void factorize(text_t& text, size_t threshold, lzss::FactorBuffer& factors) {
 
 		// Construct SA, ISA and LCP
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/TextDS.hpp>
+#include <tudocomp/def.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp/compressors/lzss/LZSSFactors.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace lcpcomp {
+
+/**
+ * Multi-threaded variant of ArraysComp.
+ *
+ * Like ArraysComp, there is one array of candidates per LCP value, and the
+ * LCP values are processed from the maximum downward. Candidates whose LCP
+ * value got decreased are pushed down lazily. Within one LCP value l,
+ * however, the valid candidates are processed in the order of their text
+ * positions: a candidate is selected iff its text position is at least l
+ * positions behind the previously selected one, which is exactly the
+ * condition under which the sequential algorithm would still find it valid.
+ * The selected factors therefore never overlap, and the erase/correct loops
+ * of all of them are run concurrently, lowering the LCP values atomically.
+ * Since only few candidates share an LCP value on highly repetitive texts,
+ * the loops are split into blocks of equal work, so the threads also share
+ * the loops of a single long factor.
+ *
+ * The resulting factorization is a valid lcpcomp factorization that only
+ * differs from that of ArraysComp in how ties between overlapping candidates
+ * with the same LCP value are broken. It does not depend on the amount of
+ * threads.
+ */
+class ArraysCompParallel : public Algorithm {
+private:
+    // minimum amount of work on an LCP value to process it in parallel
+    static constexpr size_t PARALLEL_MIN_WORK = 1ULL << 14;
+
+    // atomically lowers an LCP value
+    inline static void lower(len_t* lcp, len_t v) {
+        len_t cur = __atomic_load_n(lcp, __ATOMIC_RELAXED);
+        while(v < cur && !__atomic_compare_exchange_n(
+            lcp, &cur, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("lcpcomp_comp", "arrays_parallel");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::dsflags_t textds_flags() {
+        return ds::SA | ds::ISA | ds::LCP;
+    }
+
+    using Algorithm::Algorithm; //import constructor
+
+    template<typename text_t>
+    inline void factorize(text_t& text, size_t threshold, lzss::FactorBuffer& factors) {
+        const size_t threads = parallel::num_threads(
+            env().option("threads").as_integer());
+
+		// Construct SA, ISA and LCP
+        // the LCP array is copied into plain integers to allow atomic updates
+        std::vector<len_t> lcp;
+        size_t max_lcp;
+        StatPhase::wrap("Construct Index Data Structures", [&] {
+            text.require(text_t::SA | text_t::ISA | text_t::LCP);
+
+            auto lcp_ds = text.release_lcp();
+            max_lcp = lcp_ds.max_lcp();
+            StatPhase::log("maxlcp", max_lcp);
+
+            lcp.resize(lcp_ds.size());
+            parallel::for_blocks(threads, lcp.size(), [&](size_t b, size_t e){
+                for(size_t i = b; i < e; ++i) lcp[i] = lcp_ds[i];
+            });
+        });
+
+        auto& sa = text.require_sa();
+        auto& isa = text.require_isa();
+
+        if(max_lcp+1 <= threshold) return; // nothing to factorize
+        const size_t cand_length = max_lcp+1-threshold;
+        std::vector<std::vector<len_t>> cand(cand_length);
+
+        StatPhase::wrap("Fill candidates", [&]{
+            for(size_t i = 1; i < sa.size(); ++i) {
+                if(lcp[i] < threshold) continue;
+                cand[lcp[i]-threshold].push_back(i);
+            }
+
+            StatPhase::log("entries", [&] () {
+                    size_t ret = 0;
+                    for(size_t i = 0; i < cand_length; ++i) {
+                        ret += cand[i].size();
+                    }
+                    return ret; }());
+        });
+
+        StatPhase::wrap("Compute Factors", [&]{
+            // pairs of text position and suffix array index
+            std::vector<std::pair<len_t, len_t>> valid;
+            std::vector<std::pair<len_t, len_t>> selected;
+            size_t parallel_levels = 0;
+
+            for(size_t maxlcp = max_lcp; maxlcp >= threshold; --maxlcp) {
+                std::vector<len_t>& candcol = cand[maxlcp-threshold];
+
+                // push down candidates that got decreased
+                valid.clear();
+                for(const len_t index : candcol) {
+                    const len_t lcp_value = lcp[index];
+                    if(lcp_value < maxlcp) {
+                        if(lcp_value < threshold) continue; // already erased
+                        cand[lcp_value-threshold].push_back(index);
+                    } else {
+                        valid.emplace_back(sa[index], index);
+                    }
+                }
+                std::vector<len_t>().swap(candcol);
+                if(valid.empty()) continue;
+
+                // select non-overlapping candidates from left to right
+                parallel::sort(valid.data(), valid.data() + valid.size(),
+                    [](const std::pair<len_t, len_t>& a, const std::pair<len_t, len_t>& b) {
+                        return a.first < b.first;
+                    }, threads);
+
+                selected.clear();
+                for(auto& c : valid) {
+                    if(selected.empty() || c.first >= selected.back().first + maxlcp) {
+                        selected.push_back(c);
+                        factors.emplace_back(c.first, sa[c.second-1], maxlcp);
+                    }
+                }
+
+                // erase suffixes on the replaced areas and correct
+                // intersecting entries, where the work of all factors is
+                // split evenly, so that even a single long factor is
+                // processed in parallel
+                auto apply = [&](size_t b, size_t e) {
+                    size_t j = b / maxlcp;
+                    len_t k = b % maxlcp;
+                    for(size_t x = b; x < e; ++x) {
+                        const len_t pos_target = selected[j].first;
+
+                        __atomic_store_n(&lcp[isa[pos_target + k]], 0, __ATOMIC_RELAXED);
+                        if(k < pos_target) lower(&lcp[isa[pos_target - k - 1]], k+1);
+
+                        if(++k == maxlcp) { k = 0; ++j; }
+                    }
+                };
+
+                const size_t work = selected.size() * maxlcp;
+                if(threads > 1 && work >= PARALLEL_MIN_WORK) {
+                    parallel::for_blocks(threads, work, apply);
+                    ++parallel_levels;
+                } else {
+                    apply(0, work);
+                }
+            }
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("parallel_levels", parallel_levels);
+        });
+    }
+};
+
+}}
@@ -18,8 +18,6 @@ namespace lcpcomp {
 /// TODO: Describe
 class BulldozerStrategy : public Algorithm {
 private:
-    typedef TextDS<> text_t;
-
     struct Interval {
         size_t p, q, l;
     };
@@ -43,9 +41,10 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA | text_t::LCP;
+        return ds::SA | ds::ISA | ds::LCP;
     }
 
+    template<typename text_t>
     inline void factorize(text_t& text,
                    size_t threshold,
                    lzss::FactorBuffer& factors) {
@@ -20,9 +20,6 @@ namespace lcpcomp {
 /// This was the original naive approach in "Textkompression mithilfe von
 /// Enhanced Suffix Arrays" (BA thesis, Patrick Dinklage, 2015).
 class MaxHeapStrategy : public Algorithm {
-private:
-    typedef TextDS<> text_t;
-
 public:
     inline static Meta meta() {
         Meta m("lcpcomp_comp", "heap");
@@ -30,11 +27,12 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA | text_t::LCP;
+        return ds::SA | ds::ISA | ds::LCP;
     }
 
     using Algorithm::Algorithm; //import constructor
 
+    template<typename text_t>
     inline void factorize(text_t& text,
                    const size_t threshold,
                    lzss::FactorBuffer& factors) {
@@ -56,7 +54,7 @@ public:
             }
 
             // Construct heap
-            ArrayMaxHeap<text_t::lcp_type::data_type> heap(lcp, lcp.size(), heap_size);
+            ArrayMaxHeap<typename text_t::lcp_type> heap(lcp, lcp.size(), heap_size);
             for(size_t i = 1; i < lcp.size(); i++) {
                 if(lcp[i] >= threshold) heap.insert(i);
             }
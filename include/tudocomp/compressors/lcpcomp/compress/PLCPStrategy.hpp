@@ -23,9 +23,6 @@ namespace lcpcomp {
 ///
 /// TODO: Describe
 class PLCPStrategy : public Algorithm {
-private:
-    typedef TextDS<> text_t;
-
 public:
     using Algorithm::Algorithm;
 
@@ -35,9 +32,10 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA;
+        return ds::SA | ds::ISA;
     }
 
+    template<typename text_t>
     inline void factorize(text_t& text,
                    size_t threshold,
                    lzss::FactorBuffer& factors) {
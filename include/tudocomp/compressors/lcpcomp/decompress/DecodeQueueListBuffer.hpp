@@ -9,6 +9,17 @@ namespace tdc {
 namespace lcpcomp {
 
 constexpr len_t undef_len = std::numeric_limits<len_t>::max();
+
+/**
+ * Decodes factors eagerly by forwarding decoded characters to all positions
+ * waiting for them.
+ * The waiting positions of each text position form a singly linked list
+ * whose nodes are stored in one pooled arena. Nodes of decoded positions are
+ * put into a free list and reused, so the arena only grows up to the maximum
+ * number of positions that wait at the same time.
+ * Chains of dependencies are followed with an explicit stack instead of
+ * recursion.
+ */
 class DecodeForwardQueueListBuffer : public Algorithm {
     public:
     inline static Meta meta() {
@@ -21,41 +32,78 @@ class DecodeForwardQueueListBuffer : public Algorithm {
     }
 
 private:
+    struct node_t {
+        len_t target; // the waiting position
+        len_t next;   // the next node in the list or undef_len
+    };
+
     std::vector<uliteral_t> m_buffer;
-    std::vector<std::vector<len_t>> m_fwd;
     BitVector m_decoded;
 
+    // head of the list of waiting positions for each text position
+    std::vector<len_t> m_head;
+
+    std::vector<node_t> m_arena;
+    len_t m_free; // head of the free list
+
+    // pairs of decoded position and its depth in the chain
+    std::vector<std::pair<len_t, len_t>> m_stack;
+
     len_t m_cursor;
 
     //stats:
     len_t m_longest_chain;
-    len_t m_current_chain;
-    len_t m_max_depth;
 
     inline void decode_literal_at(len_t pos, uliteral_t c) {
-        ++m_current_chain;
-        m_longest_chain = std::max(m_longest_chain, m_current_chain);
-        m_max_depth = std::max<len_t>(m_max_depth, m_fwd[pos].size());
-
         m_buffer[pos] = c;
         m_decoded[pos] = 1;
+        m_stack.emplace_back(pos, 1);
+
+        while(!m_stack.empty()) {
+            const len_t src = m_stack.back().first;
+            const len_t depth = m_stack.back().second;
+            m_stack.pop_back();
+            m_longest_chain = std::max(m_longest_chain, depth);
 
-        for(auto fwd : m_fwd[pos]) {
-            decode_literal_at(fwd, c); // recursion
+            len_t node = m_head[src];
+            m_head[src] = undef_len;
+            while(node != undef_len) {
+                const len_t target = m_arena[node].target;
+                const len_t next = m_arena[node].next;
+
+                m_buffer[target] = c;
+                m_decoded[target] = 1;
+                m_stack.emplace_back(target, depth + 1);
+
+                // return the node to the free list
+                m_arena[node].next = m_free;
+                m_free = node;
+
+                node = next;
+            }
         }
-        std::vector<len_t>().swap(m_fwd[pos]); // forces vector to drop to capacity 0
-//        m_fwd[pos].clear();
+    }
 
-        --m_current_chain;
+    inline void wait_for(len_t src, len_t target) {
+        len_t node;
+        if(m_free != undef_len) {
+            node = m_free;
+            m_free = m_arena[node].next;
+        } else {
+            node = m_arena.size();
+            m_arena.emplace_back();
+        }
+        m_arena[node] = node_t { target, m_head[src] };
+        m_head[src] = node;
     }
 
 public:
     inline DecodeForwardQueueListBuffer(Env&& env, len_t size)
-        : Algorithm(std::move(env)), m_cursor(0), m_longest_chain(0), m_current_chain(0), m_max_depth(0) {
+        : Algorithm(std::move(env)), m_free(undef_len), m_cursor(0), m_longest_chain(0) {
 
         m_buffer.resize(size, 0);
-        m_fwd.resize(size, std::vector<len_t>());
         m_decoded = BitVector(size, 0);
+        m_head.resize(size, undef_len);
     }
 
     inline void decode_literal(uliteral_t c) {
@@ -68,7 +116,7 @@ public:
             if(m_decoded[src]) {
                 decode_literal_at(m_cursor, m_buffer[src]);
             } else {
-                m_fwd[src].push_back(m_cursor);
+                wait_for(src, m_cursor);
             }
 
             ++m_cursor;
@@ -85,4 +133,3 @@ public:
 };
 
 }} //ns
-
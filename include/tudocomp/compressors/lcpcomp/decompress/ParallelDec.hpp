@@ -0,0 +1,180 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <tudocomp/def.hpp>
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace lcpcomp {
+
+/**
+ * Decodes lcpcomp compressed data in parallel rounds.
+ * Literals and all characters of factors whose sources are already known are
+ * decoded immediately, the remaining factors are stored.
+ * In each round, all stored factors are scanned in parallel, copying every
+ * character whose source has been decoded in the meantime. Since factors
+ * never overlap, every text position has only one writer.
+ * Fully decoded factors are dropped, and the others are trimmed to their
+ * undecoded parts. As soon as a round decodes only a small fraction of
+ * the remaining characters (i.e., only long dependency chains are left),
+ * the rest is decoded sequentially by following the dependencies.
+ */
+class ParallelDec : public Algorithm {
+public:
+    inline static Meta meta() {
+        Meta m("lcpcomp_dec", "parallel");
+        m.option("threads").dynamic(0);
+        m.option("max_rounds").dynamic(64);
+        return m;
+    }
+
+private:
+    struct factor_t {
+        len_t target, source, length;
+    };
+
+    len_t m_cursor;
+    std::vector<uliteral_t> m_buffer;
+    std::vector<factor_t> m_factors;
+
+    // positions are accessed concurrently during the rounds
+    inline uliteral_t load(len_t pos) const {
+        return __atomic_load_n(&m_buffer[pos], __ATOMIC_RELAXED);
+    }
+
+    inline void store(len_t pos, uliteral_t c) {
+        __atomic_store_n(&m_buffer[pos], c, __ATOMIC_RELAXED);
+    }
+
+    // copies all available characters and trims the factor to its
+    // undecoded part, returns the amount of decoded characters
+    inline len_t scan(factor_t& f) {
+        len_t decoded = 0;
+        for(len_t i = 0; i < f.length; ++i) {
+            if(load(f.target + i)) continue;
+            const uliteral_t c = load(f.source + i);
+            if(c) {
+                store(f.target + i, c);
+                ++decoded;
+            }
+        }
+
+        while(f.length > 0 && load(f.target)) {
+            ++f.target; ++f.source; --f.length;
+        }
+        while(f.length > 0 && load(f.target + f.length - 1)) {
+            --f.length;
+        }
+        return decoded;
+    }
+
+    // decodes the remaining factors by following their dependencies
+    inline void decode_sequentially() {
+        // pairs of source and target position of undecoded characters
+        std::vector<std::pair<len_t, len_t>> deps;
+        for(auto& f : m_factors) {
+            for(len_t i = 0; i < f.length; ++i) {
+                if(!m_buffer[f.target + i]) deps.emplace_back(f.source + i, f.target + i);
+            }
+        }
+        std::vector<factor_t>().swap(m_factors);
+        std::sort(deps.begin(), deps.end());
+
+        std::vector<len_t> stack;
+        for(auto& d : deps) {
+            if(m_buffer[d.second] || !m_buffer[d.first]) continue;
+
+            m_buffer[d.second] = m_buffer[d.first];
+            stack.push_back(d.second);
+
+            // propagate to all positions waiting for a decoded one
+            while(!stack.empty()) {
+                const len_t pos = stack.back();
+                stack.pop_back();
+
+                auto it = std::lower_bound(deps.begin(), deps.end(),
+                    std::make_pair(pos, len_t(0)));
+                for(; it != deps.end() && it->first == pos; ++it) {
+                    if(!m_buffer[it->second]) {
+                        m_buffer[it->second] = m_buffer[pos];
+                        stack.push_back(it->second);
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    inline ParallelDec(Env&& env, len_t size)
+        : Algorithm(std::move(env)), m_cursor(0), m_buffer(size, 0) {
+    }
+
+    inline void decode_literal(uliteral_t c) {
+        m_buffer[m_cursor++] = c;
+        DCHECK(c != 0 || m_cursor == m_buffer.size()); // we assume that the text to restore does not contain a NULL-byte but at its very end
+    }
+
+    inline void decode_factor(const len_t source_position, const len_t factor_length) {
+        factor_t f { m_cursor, source_position, factor_length };
+        for(len_t i = 0; i < factor_length; ++i) {
+            m_buffer[m_cursor + i] = m_buffer[source_position + i];
+        }
+        m_cursor += factor_length;
+
+        scan(f);
+        if(f.length > 0) m_factors.push_back(f);
+    }
+
+    inline void decode_lazy() {
+        const size_t threads = parallel::num_threads(
+            env().option("threads").as_integer());
+        const size_t max_rounds = env().option("max_rounds").as_integer();
+
+        size_t remaining = 0;
+        for(auto& f : m_factors) remaining += f.length;
+
+        StatPhase::log("threads", threads);
+        StatPhase::log("remaining factors", m_factors.size());
+
+        size_t rounds = 0;
+        std::vector<size_t> decoded(threads);
+        while(!m_factors.empty() && rounds < max_rounds) {
+            std::fill(decoded.begin(), decoded.end(), 0);
+
+            parallel::run(threads, [&](size_t tid){
+                const size_t n = m_factors.size();
+                const size_t b = (n * tid) / threads;
+                const size_t e = (n * (tid + 1)) / threads;
+                for(size_t j = b; j < e; ++j) decoded[tid] += scan(m_factors[j]);
+            });
+            ++rounds;
+
+            m_factors.erase(std::remove_if(m_factors.begin(), m_factors.end(),
+                [](const factor_t& f){ return f.length == 0; }), m_factors.end());
+
+            size_t sum = 0;
+            for(auto d : decoded) sum += d;
+
+            // stop if only long dependency chains are left
+            if(sum * 8 < remaining) break;
+            remaining -= sum;
+        }
+
+        StatPhase::log("rounds", rounds);
+    }
+
+    inline void decode_eagerly() {
+        StatPhase::log("remaining factors", m_factors.size());
+        decode_sequentially();
+    }
+
+    inline void write_to(std::ostream& out) const {
+        out.write((const char*)m_buffer.data(), m_buffer.size());
+    }
+};
+
+}} //ns
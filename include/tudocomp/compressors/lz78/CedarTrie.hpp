@@ -35,21 +35,6 @@ public:
     inline const CedarSearchPos& search_pos() const { return m_search_pos; }
 };
 
-class LzwRootSearchPosMap {
-    std::array<CedarSearchPos, 256> m_array;
-public:
-    inline CedarSearchPos get(uliteral_t c) {
-        DCHECK(0 <= c);
-        DCHECK(c < m_array.size());
-        return m_array[c];
-    }
-    inline void set(uliteral_t c, CedarSearchPos v) {
-        DCHECK(0 <= c);
-        DCHECK(c < m_array.size());
-        m_array[c] = v;
-    }
-};
-
 const uint8_t NULL_ESCAPE_ESCAPE_BYTE = 255;
 const uint8_t NULL_ESCAPE_REPLACEMENT_BYTE = 254;
 
@@ -59,7 +44,6 @@ class CedarTrie: public Algorithm, public LZ78Trie<CedarSearchPos> {
     // unique_ptr only needed for reassignment
     std::unique_ptr<cedar_t> m_trie;
     cedar_factorid_t m_ids = 0;
-    LzwRootSearchPosMap m_roots;
 
     inline node_t _find_or_insert(const node_t& parent, uliteral_t c, bool incr_id) {
         auto search_pos = parent.search_pos();
@@ -224,7 +208,6 @@ public:
             search_pos = CedarSearchPos{ from };
         }
         auto r = node_t(ids, search_pos);
-        m_roots.set(c, search_pos);
         /*
         DLOG(INFO) << "add rootnode "
             << "char: " << int(c)
@@ -237,7 +220,21 @@ public:
     }
 
     inline node_t get_rootnode(uliteral_t c) override final {
-        return node_t(c, m_roots.get(c));
+        // cedar may relocate the root nodes when inserting new nodes,
+        // so their search positions cannot be cached
+        size_t from = 0;
+        size_t pos = 0;
+        if (c != 0 && c != NULL_ESCAPE_ESCAPE_BYTE) {
+            m_trie->traverse((const char*) &c, from, pos, 1);
+        } else {
+            const uint8_t path[] = {
+                NULL_ESCAPE_ESCAPE_BYTE,
+                (c == 0) ? NULL_ESCAPE_REPLACEMENT_BYTE : c,
+            };
+            m_trie->traverse((const char*) path, from, pos, 2);
+        }
+        DCHECK(pos == ((c != 0 && c != NULL_ESCAPE_ESCAPE_BYTE) ? 1 : 2));
+        return node_t(c, CedarSearchPos{ from });
     }
 
     inline void clear() override final {
@@ -245,7 +242,6 @@ public:
         // seems to have bugs in its implementation
         m_trie = std::make_unique<cedar_t>();
         m_ids = 0;
-        m_roots = LzwRootSearchPosMap();
     }
 
     inline node_t find_or_insert(const node_t& parent, uliteral_t c) override final {
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/compressors/lz78/LZ78Trie.hpp>
+
+namespace tdc {
+namespace lz78 {
+
+/// \cond INTERNAL
+namespace compact_hash {
+
+/// Returns the inverse of an odd integer modulo 2^64.
+constexpr uint64_t mul_inverse(uint64_t a, uint64_t x = 1, size_t i = 0) {
+    return (i == 6) ? x : mul_inverse(a, x * (2 - a * x), i + 1);
+}
+
+/// \brief A linear probing hash table of (parent, literal) keys and node ids
+///        that stores only part of each key (see [Cleary, 1984]).
+///
+/// A key of \c w bits is mapped to \c w bits using a bijective hash
+/// function. The lowest \c bits of the hash determine the initial slot of
+/// the key, and only the remaining bits are stored in the slot together
+/// with the distance to the initial slot. Hence, a key can be restored from
+/// its slot.
+///
+/// Keys have eight bits more than the slot index, which are stored as the
+/// remainder. Hence, only keys with parent ids smaller than the amount of
+/// slots can be stored, and wider keys are never found.
+class Table {
+    static constexpr uint64_t MUL = 0x9E3779B97F4A7C15ULL;
+    static constexpr uint64_t MUL_INV = mul_inverse(MUL);
+
+    // slot states are stored in four bits: STATE_EMPTY, the displacement
+    // plus one, or STATE_OVERFLOW for displacements stored in m_overflow
+    enum : uint8_t {
+        STATE_EMPTY = 0,
+        STATE_OVERFLOW = 15,
+    };
+
+    size_t m_bits;      // the table has 2^m_bits slots
+    size_t m_key_bits;  // the bit width of keys
+    uint64_t m_key_mask;
+
+    std::vector<uliteral_t> m_rems; // key remainders
+    std::vector<uint8_t> m_states;  // slot states, two per byte
+    DynamicIntVector m_values;      // node ids
+    std::unordered_map<size_t, size_t> m_overflow; // large displacements
+
+    size_t m_entries;
+
+    inline uint64_t hash(uint64_t x) const {
+        const size_t shift = (m_key_bits + 1) / 2;
+        x ^= x >> shift;
+        x = (x * MUL) & m_key_mask;
+        x ^= x >> shift;
+        return x;
+    }
+
+    inline uint64_t unhash(uint64_t x) const {
+        const size_t shift = (m_key_bits + 1) / 2;
+        x ^= x >> shift;
+        x = (x * MUL_INV) & m_key_mask;
+        x ^= x >> shift;
+        return x;
+    }
+
+    inline uint8_t state(size_t i) const {
+        return (m_states[i / 2] >> (4 * (i % 2))) & 0xF;
+    }
+
+    inline void set_state(size_t i, uint8_t s) {
+        uint8_t& b = m_states[i / 2];
+        b = (b & ~(0xF << (4 * (i % 2)))) | (s << (4 * (i % 2)));
+    }
+
+    // the displacement of the non-empty slot i
+    inline size_t disp(size_t i, uint8_t s) const {
+        return (s == STATE_OVERFLOW) ? m_overflow.at(i) : size_t(s - 1);
+    }
+
+    // returns the slot of key x, or the empty slot to insert it into
+    inline size_t locate(uint64_t x, size_t& d, bool& found) const {
+        const uint64_t h = hash(x);
+        const size_t mask = slots() - 1;
+        const uliteral_t rem = uliteral_t(h >> m_bits);
+
+        size_t i = h & mask;
+        for(d = 0;; ++d, i = (i + 1) & mask) {
+            const uint8_t s = state(i);
+            if(s == STATE_EMPTY) break;
+
+            if(m_rems[i] == rem && disp(i, s) == d) {
+                found = true;
+                return i;
+            }
+        }
+
+        found = false;
+        return i;
+    }
+
+public:
+    /// Constructs a table without slots.
+    inline Table()
+        : m_bits(0), m_key_bits(0), m_key_mask(0), m_entries(0) {
+    }
+
+    /// Constructs an empty table with 2^bits slots.
+    inline explicit Table(size_t bits)
+        : m_bits(bits),
+          m_key_bits(bits + 8 * sizeof(uliteral_t)),
+          m_key_mask((1ULL << m_key_bits) - 1ULL),
+          m_rems(1ULL << bits),
+          m_states(idiv_ceil(1ULL << bits, 2U), STATE_EMPTY),
+          m_values(1ULL << bits, 0, bits_for((1ULL << bits) - 1)),
+          m_entries(0) {
+    }
+
+    inline size_t bits() const { return m_bits; }
+    inline size_t slots() const { return m_rems.size(); }
+    inline size_t entries() const { return m_entries; }
+
+    /// Returns the key stored in slot i, or false if the slot is empty.
+    inline bool key(size_t i, uint64_t& x, factorid_t& value) const {
+        const uint8_t s = state(i);
+        if(s == STATE_EMPTY) return false;
+
+        const size_t home = (i - disp(i, s)) & (slots() - 1);
+        x = unhash((uint64_t(m_rems[i]) << m_bits) | home);
+        value = factorid_t(m_values[i]);
+        return true;
+    }
+
+    /// Searches the key x and returns its value, or undef_id.
+    inline factorid_t find(uint64_t x) const {
+        // the hash function is only bijective on keys of m_key_bits bits
+        if(x > m_key_mask) return undef_id;
+
+        size_t d;
+        bool found;
+        const size_t i = locate(x, d, found);
+        return found ? factorid_t(m_values[i]) : undef_id;
+    }
+
+    /// Inserts the key x with the given value, which must be smaller than
+    /// the amount of slots, if the key does not exist yet.
+    ///
+    /// \return The value of the key, or undef_id if it was inserted.
+    inline factorid_t find_or_insert(uint64_t x, factorid_t value) {
+        DCHECK_LE(x, m_key_mask);
+        DCHECK_LT(value, slots());
+        DCHECK_LT(m_entries + 1, slots());
+
+        size_t d;
+        bool found;
+        const size_t i = locate(x, d, found);
+        if(found) return factorid_t(m_values[i]);
+
+        m_rems[i] = uliteral_t(hash(x) >> m_bits);
+        if(d + 1 >= STATE_OVERFLOW) {
+            set_state(i, STATE_OVERFLOW);
+            m_overflow[i] = d;
+        } else {
+            set_state(i, uint8_t(d + 1));
+        }
+        m_values[i] = value;
+        ++m_entries;
+        return undef_id;
+    }
+
+    /// Removes all keys, but keeps the allocated storage.
+    inline void clear() {
+        std::fill(m_states.begin(), m_states.end(), STATE_EMPTY);
+        m_overflow.clear();
+        m_entries = 0;
+    }
+};
+
+}
+/// \endcond
+
+/// \brief A compact hash table trie.
+///
+/// Each node is stored in a slot of a hash table, which holds the literal
+/// of the node, the distance to the slot the node was hashed to and the node
+/// id as packed integers. The parent id is not stored, but restored from the
+/// slot position, see \ref compact_hash::Table.
+///
+/// When the table is filled, its size is doubled. The nodes are moved to
+/// the new table a few at a time with each subsequent operation, so that no
+/// operation has to rehash the whole table.
+class CompactHashTrie : public Algorithm, public LZ78Trie<factorid_t> {
+    using table_t = compact_hash::Table;
+
+    // the amount of slots moved to the new table per operation
+    static constexpr size_t MIGRATE_STEP = 4;
+
+    static constexpr size_t MIN_BITS = 8;
+
+    float m_load_factor;
+    size_t m_capacity; // the amount of nodes before the table grows
+
+    table_t m_table;
+    table_t m_old;     // the previous table while its nodes are moved
+    size_t m_migrated; // the amount of slots moved from m_old
+
+    factorid_t m_size;
+
+    inline bool migrating() const {
+        return m_migrated < m_old.slots();
+    }
+
+    inline void migrate(size_t count) {
+        for(; count > 0 && migrating(); --count, ++m_migrated) {
+            uint64_t x;
+            factorid_t id;
+            if(m_old.key(m_migrated, x, id)) {
+                m_table.find_or_insert(x, id);
+            }
+        }
+
+        if(!migrating()) {
+            m_old = table_t(); // release
+            m_migrated = 0;
+        }
+    }
+
+    inline void init(size_t bits) {
+        m_table = table_t(bits);
+        m_capacity = size_t(m_table.slots() * m_load_factor);
+    }
+
+    inline void grow() {
+        migrate(m_old.slots()); // finish the previous growth
+
+        m_old = std::move(m_table);
+        m_migrated = 0;
+        init(m_old.bits() + 1);
+    }
+
+    static inline uint64_t key(factorid_t parent, uliteral_t c) {
+        return (uint64_t(parent) << (8 * sizeof(uliteral_t))) | uint64_t(c);
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("lz78trie", "compact_hash", "Lempel-Ziv 78 Compact Hash Trie");
+        m.option("load_factor").dynamic(80);
+        return m;
+    }
+
+    /// \brief Constructs an empty trie.
+    ///
+    /// \param env The algorithm's environment.
+    /// \param reserve The amount of nodes to allocate memory for.
+    inline CompactHashTrie(Env&& env, factorid_t reserve = 0)
+        : Algorithm(std::move(env)),
+          m_migrated(0),
+          m_size(0) {
+
+        m_load_factor = this->env().option("load_factor").as_integer() / 100.0f;
+        CHECK(m_load_factor > 0.0f && m_load_factor < 1.0f)
+            << "load_factor must be between 0 and 100";
+
+        size_t bits = MIN_BITS;
+        while((1ULL << bits) * m_load_factor < reserve) ++bits;
+        init(bits);
+    }
+
+    inline node_t add_rootnode(uliteral_t) override {
+        return m_size++;
+    }
+
+    inline node_t get_rootnode(uliteral_t c) override {
+        return c;
+    }
+
+    inline void clear() override {
+        m_old = table_t();
+        m_migrated = 0;
+        m_table.clear();
+        m_size = 0;
+    }
+
+    inline node_t find_or_insert(const node_t& parent, uliteral_t c) override {
+        const uint64_t x = key(parent.id(), c);
+
+        if(tdc_unlikely(migrating())) {
+            migrate(MIGRATE_STEP);
+
+            // the node may not have been moved yet, unless its parent was
+            // inserted after the growth
+            const factorid_t id = migrating() ? m_old.find(x) : undef_id;
+            if(id != undef_id) return id;
+        }
+
+        if(tdc_unlikely(m_size >= m_capacity)) {
+            const factorid_t id = m_table.find(x);
+            if(id != undef_id) return id;
+            grow();
+        }
+
+        const factorid_t id = m_table.find_or_insert(x, m_size);
+        if(id == undef_id) ++m_size;
+        return id;
+    }
+
+    inline factorid_t size() const override {
+        return m_size;
+    }
+};
+
+}} //ns
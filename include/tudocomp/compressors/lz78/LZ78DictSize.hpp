@@ -0,0 +1,20 @@
+#pragma once
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/compressors/lz78/LZ78Trie.hpp>
+
+namespace tdc {
+namespace lz78 {
+
+/// Parses a dictionary size option as described by \ref LZ78_DICT_SIZE_DESC.
+/// An unlimited size is returned as zero.
+inline factorid_t select_size(Env& env, string_ref name) {
+    auto& o = env.option(name);
+    if (o.as_string() == "inf") {
+        return 0;
+    } else {
+        return o.as_integer();
+    }
+}
+
+}} //ns
@@ -32,7 +32,7 @@ public:
 };
 
 #define LZ78_DICT_SIZE_DESC \
-			"`dict_size` has to either be 0 (unlimited), or a positive integer,\n" \
+			"`dict_size` has to either be \"inf\" or 0 (unlimited), or a positive integer,\n" \
 			"and determines the maximum size of the backing storage of\n" \
 			"the dictionary before it gets reset."
 
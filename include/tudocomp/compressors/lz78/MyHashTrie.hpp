@@ -96,6 +96,12 @@ class MyHash {
 		}
 	};
 
+	/// Removes all entries, but keeps the allocated table.
+	void clear() {
+		for(size_t i = 0; i < m_size; ++i) m_values[i] = empty_val;
+		m_entries = 0;
+	}
+
 	inline len_t entries() const { return m_entries; }
 	inline len_t table_size() const { return m_size; }
 
@@ -175,8 +181,7 @@ public:
     }
 
 	void clear() override {
-//		table.clear();
-
+		table.clear();
 	}
 
     node_t find_or_insert(const node_t& parent_w, uliteral_t c) override {
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <vector>
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/TextDS.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace lz78u {
+
+/// \brief The suffix tree of a text, represented by the LCP intervals of
+///        its suffix array.
+///
+/// Each internal node is an interval of the suffix array whose suffixes
+/// share a prefix of the node's string depth. The intervals are computed
+/// bottom-up from the LCP array (see [Abouelhoda et al., 2004]). For each
+/// internal node, only its string depth, the first character of its edge
+/// and its internal children are stored. The suffix and LCP array are
+/// released after the construction. The leaf of the suffix starting at
+/// text position \c i is identified by <tt>internal_nodes() + i</tt>.
+///
+/// The children of a node are sorted by the first characters of their
+/// edges, so the child on the path to a leaf is found by binary search
+/// for the character of the leaf's suffix at the node's string depth.
+/// Hence, walking down from the root to the deepest ancestor of a leaf with
+/// some property, as done by \ref LZ78UCompressor, answers the weighted
+/// ancestor query without the level ancestor support of a balanced
+/// parentheses representation.
+///
+/// The suffix and LCP array are constructed bit-compressed, and the node
+/// arrays are allocated with their final sizes after counting the nodes.
+/// On a random text over four characters, the tree takes about 4.2 bytes
+/// per character, and the construction peaks at about 7.5 bytes per
+/// character, since the suffix and LCP array are alive while the tree is
+/// built.
+///
+/// The text must outlive the tree.
+template<typename text_t = TextDS<>>
+class LCPIntervalTree : public Algorithm {
+public:
+    using node_type = size_t;
+
+private:
+    View m_text;
+    size_t m_internal_nodes;
+
+    DynamicIntVector m_depth;          // string depth of each internal node
+    std::vector<uliteral_t> m_char;    // first character of each edge
+    DynamicIntVector m_first_child;    // children of node v are in
+                                       // [m_first_child[v], m_first_child[v+1])
+    DynamicIntVector m_children;       // internal children, sorted by m_char
+
+public:
+    inline static Meta meta() {
+        Meta m("lz78u_tree", "lcp_intervals",
+            "Suffix tree represented by the LCP intervals of the text");
+        m.option("textds").templated<text_t, TextDS<>>("textds");
+        return m;
+    }
+
+    /// \brief Constructs the suffix tree of a text.
+    ///
+    /// \param env The algorithm's environment.
+    /// \param text The text, which ends with a unique sentinel.
+    inline LCPIntervalTree(Env&& env, const View& text)
+        : Algorithm(std::move(env)), m_text(text) {
+
+        // the peak memory of the construction is that of this phase
+        StatPhase::wrap("Construct LCP Interval Tree", [&]{
+            text_t t(this->env().env_for_option("textds"), text,
+                text_t::SA | text_t::LCP, CompressMode::compressed);
+
+            StatPhase::wrap("Construct LCP Intervals", [&]{
+                auto& sa = t.require_sa();
+                auto& lcp = t.require_lcp();
+                const len_t n = t.size();
+
+                // the open intervals, with the position of their first
+                // child in pending
+                struct interval_t { len_t depth, lb; size_t first; };
+                std::vector<interval_t> stack;
+
+                // count the intervals first, so that the node arrays are
+                // allocated with their final sizes and widths
+                size_t nodes = 1;
+                len_t max_depth = 0;
+                stack.push_back(interval_t { 0, 0, 0 });
+                for(len_t i = 1; i < n; i++) {
+                    const len_t l = lcp[i];
+                    for(; l < stack.back().depth; stack.pop_back()) ++nodes;
+                    if(l > stack.back().depth) stack.push_back(interval_t { l, 0, 0 });
+                    max_depth = std::max(max_depth, l);
+                }
+                nodes += stack.size() - 1;
+                stack.clear();
+
+                const size_t w = bits_for(nodes);
+                m_internal_nodes = nodes;
+                m_depth = DynamicIntVector(nodes, 0, bits_for(max_depth));
+                m_char = std::vector<uliteral_t>(nodes, 0);
+                m_first_child = DynamicIntVector(nodes + 1, 0, w);
+                m_children = DynamicIntVector(nodes - 1, 0, w);
+
+                // internal children of the intervals on the stack, whose
+                // parent has not been completed yet, with their left bounds
+                struct child_t { len_t node, lb; };
+                std::vector<child_t> pending;
+
+                size_t v = 0; // the next node
+                size_t k = 0; // the next position in m_children
+                auto complete = [&](len_t depth, len_t lb, size_t first) {
+                    m_depth[v] = depth;
+                    m_first_child[v] = k;
+                    for(size_t j = first; j < pending.size(); j++) {
+                        const child_t& c = pending[j];
+                        m_char[c.node] = m_text[sa[c.lb] + depth];
+                        m_children[k++] = c.node;
+                    }
+                    pending.resize(first);
+                    pending.push_back(child_t { len_t(v++), lb });
+                };
+
+                stack.push_back(interval_t { 0, 0, 0 });
+                for(len_t i = 1; i < n; i++) {
+                    const len_t l = lcp[i];
+                    len_t lb = i - 1;
+                    bool closed = false;
+
+                    while(l < stack.back().depth) {
+                        const interval_t top = stack.back();
+                        stack.pop_back();
+
+                        complete(top.depth, top.lb, top.first);
+                        lb = top.lb;
+                        closed = true;
+                    }
+
+                    if(l > stack.back().depth) {
+                        // the last closed interval is a child of the new one
+                        stack.push_back(interval_t {
+                            l, lb, closed ? pending.size() - 1 : pending.size() });
+                    }
+                }
+
+                // close the remaining intervals, the root last
+                while(!stack.empty()) {
+                    const interval_t top = stack.back();
+                    stack.pop_back();
+                    complete(top.depth, top.lb, top.first);
+                }
+
+                DCHECK_EQ(v, nodes);
+                DCHECK_EQ(k, nodes - 1);
+                m_first_child[nodes] = k;
+            });
+
+            StatPhase::log("internal nodes", m_internal_nodes);
+            StatPhase::log("size", (m_depth.bit_size() + m_first_child.bit_size()
+                + m_children.bit_size()) / 8 + m_char.size());
+        });
+    }
+
+    /// Returns the root node.
+    inline node_type root() const {
+        return m_internal_nodes - 1;
+    }
+
+    /// Returns the leaf of the suffix starting at text position \c pos.
+    inline node_type leaf(len_t pos) const {
+        return m_internal_nodes + pos;
+    }
+
+    /// Tests whether a node is a leaf.
+    inline bool is_leaf(node_type v) const {
+        return v >= m_internal_nodes;
+    }
+
+    /// Returns the child of the internal node \c v on the path to the
+    /// descendant leaf \c l.
+    inline node_type child(node_type v, node_type l) const {
+        DCHECK(!is_leaf(v));
+        DCHECK(is_leaf(l));
+
+        // the suffix is longer than the string depth of v, because the
+        // sentinel is unique
+        const uliteral_t c = m_text[l - m_internal_nodes + m_depth[v]];
+
+        // find the internal child whose edge starts with c
+        size_t lo = m_first_child[v];
+        size_t hi = m_first_child[v + 1];
+        while(lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            const size_t u = m_children[mid];
+            if(m_char[u] < c) {
+                lo = mid + 1;
+            } else if(m_char[u] > c) {
+                hi = mid;
+            } else {
+                return u;
+            }
+        }
+        return l;
+    }
+
+    /// Returns the string depth of the internal node \c v.
+    inline len_t str_depth(node_type v) const {
+        DCHECK(!is_leaf(v));
+        return m_depth[v];
+    }
+
+    /// Returns the identifier of the internal node \c v, which is smaller
+    /// than the amount of internal nodes.
+    inline size_t nid(node_type v) const {
+        DCHECK(!is_leaf(v));
+        return v;
+    }
+
+    /// Returns the amount of internal nodes.
+    inline size_t internal_nodes() const {
+        return m_internal_nodes;
+    }
+};
+
+}} //ns
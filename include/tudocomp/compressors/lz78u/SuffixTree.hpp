@@ -3,8 +3,14 @@
 #include <sdsl/suffix_trees.hpp>
 #include <glog/logging.h>
 
+#include <memory>
 #include <sstream>
 
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/util/View.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
 using namespace sdsl;
 
 //template<class bp_support = sdsl::bp_support_sada<> >
@@ -113,6 +119,72 @@ struct SuffixTree {
 
 };
 
+/// \brief The suffix tree of a text, represented by sdsl's \c cst_sada.
+///
+/// This provides the interface of \ref LCPIntervalTree for
+/// \ref LZ78UCompressor.
+class CSTSada : public Algorithm {
+public:
+    using node_type = SuffixTree::node_type;
+
+private:
+    SuffixTree::cst_t m_cst;
+    std::unique_ptr<SuffixTree> m_st;
+
+public:
+    inline static Meta meta() {
+        Meta m("lz78u_tree", "cst_sada", "Suffix tree using sdsl's cst_sada");
+        return m;
+    }
+
+    /// \brief Constructs the suffix tree of a text.
+    ///
+    /// \param env The algorithm's environment.
+    /// \param text The text, which ends with a unique sentinel.
+    inline CSTSada(Env&& env, const View& text)
+        : Algorithm(std::move(env)) {
+
+        StatPhase::wrap("construct suffix tree", [&]{
+            // TODO: Specialize sdsl template for less alloc here
+            std::string bad_copy_1 = text.slice(0, text.size() - 1);
+            construct_im(m_cst, bad_copy_1, 1);
+        });
+        m_st = std::make_unique<SuffixTree>(m_cst);
+    }
+
+    // m_st refers to m_cst
+    CSTSada(const CSTSada&) = delete;
+    CSTSada& operator=(const CSTSada&) = delete;
+
+    inline node_type root() const {
+        return m_st->root;
+    }
+
+    inline node_type leaf(len_t pos) const {
+        return m_st->select_leaf(m_cst.csa.isa[pos]);
+    }
+
+    inline bool is_leaf(const node_type& v) const {
+        return m_cst.is_leaf(v);
+    }
+
+    inline node_type child(const node_type& v, const node_type& l) const {
+        return m_st->level_anc(l, m_cst.node_depth(v) + 1);
+    }
+
+    inline len_t str_depth(const node_type& v) const {
+        return m_st->str_depth(v);
+    }
+
+    inline size_t nid(const node_type& v) const {
+        return m_st->nid(v);
+    }
+
+    inline size_t internal_nodes() const {
+        return m_st->internal_nodes;
+    }
+};
+
 inline void reset_bitvector(bit_vector& bv) { //! resets a bit-vector, clearing all ones
 	sdsl::util::set_to_value(bv, 0);
 }
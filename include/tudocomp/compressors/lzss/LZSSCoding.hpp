@@ -15,6 +15,27 @@
 namespace tdc {
 namespace lzss {
 
+/// \cond INTERNAL
+// encodes the literals text[from..to-1] at once if the coder supports it
+template<typename coder_t, typename text_t>
+inline auto encode_literals(coder_t& coder, const text_t& text,
+                            size_t from, size_t to, int)
+    -> decltype(coder.encode_literals(View(text.text(), 0)), void()) {
+
+    coder.encode_literals(View(text.text() + from, to - from));
+}
+
+// encodes the literals text[from..to-1] one by one
+template<typename coder_t, typename text_t>
+inline void encode_literals(coder_t& coder, const text_t& text,
+                            size_t from, size_t to, long) {
+
+    while(from < to) {
+        coder.encode(text[from++], literal_r);
+    }
+}
+/// \endcond
+
 template<typename coder_t, typename text_t>
 inline void encode_text(coder_t& coder,
                         const text_t& text,
@@ -68,9 +89,8 @@ inline void encode_text(coder_t& coder,
         }
 
         // encode literals until cursor reaches factor i
-        while(p < f.pos) {
-            coder.encode(text[p++], literal_r);
-        }
+        encode_literals(coder, text, p, f.pos, 0);
+        p = f.pos;
 
         // encode factor
         DCHECK_LT(f.src + f.len, n);
@@ -85,10 +105,8 @@ inline void encode_text(coder_t& coder,
         coder.encode(n - p, fdist_r);
     }
 
-    while(p < n)  {
-        // encode symbol
-        coder.encode(text[p++], literal_r);
-    }
+    // encode remaining literals
+    encode_literals(coder, text, p, n, 0);
 }
 
 template<typename coder_t, typename decode_buffer_t>
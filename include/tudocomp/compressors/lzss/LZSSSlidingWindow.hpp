@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <tudocomp/def.hpp>
+#include <tudocomp/util.hpp>
+
+namespace tdc {
+namespace lzss {
+
+/// \brief A sliding window over a stream of literals that finds the longest
+///        previous occurrence of the upcoming literals.
+///
+/// The window is a ring buffer containing the last \c window literals
+/// (the back buffer) followed by up to \c max_len literals that have not
+/// been processed yet (the lookahead). Positions of the back buffer are
+/// kept in hash chains, indexed by the hash of the literals starting at
+/// them, so that only positions sharing a prefix with the lookahead are
+/// compared against it (see [zlib]).
+///
+/// Positions are counted from the beginning of the stream.
+class SlidingWindow {
+private:
+    static constexpr size_t HASH_LEN = 3; // maximum amount of hashed literals
+
+    size_t m_window;
+    size_t m_max_len;
+    size_t m_hash_len;
+    size_t m_max_chain;
+    size_t m_nice_len;
+
+    std::vector<uliteral_t> m_buffer;
+    size_t m_buffer_mask;
+
+    // m_head[h] is the last position with hash h plus one, or zero
+    std::vector<size_t> m_head;
+    size_t m_hash_shift;
+
+    // m_prev[i] is the distance from position i to the previous position
+    // with the same hash, or zero if there is none within the window
+    std::vector<len_t> m_prev;
+    size_t m_prev_mask;
+
+    size_t m_pos;      // the first position of the lookahead
+    size_t m_end;      // the position after the last literal
+    size_t m_inserted; // the first position not yet in the hash chains
+
+    inline uliteral_t at(size_t i) const {
+        return m_buffer[i & m_buffer_mask];
+    }
+
+    inline size_t hash(size_t i) const {
+        uint32_t key = 0;
+        for(size_t j = 0; j < m_hash_len; j++) {
+            key = (key << 8) | at(i + j);
+        }
+        return size_t((key * 0x9E3779B1U) >> m_hash_shift);
+    }
+
+    // inserts the positions of the back buffer into the hash chains, as
+    // long as enough literals are available to hash them
+    inline void update() {
+        for(; m_inserted < m_pos && m_inserted + m_hash_len <= m_end; ++m_inserted) {
+            const size_t h = hash(m_inserted);
+            const size_t last = m_head[h];
+            const size_t dist = (last > 0) ? m_inserted + 1 - last : 0;
+
+            m_prev[m_inserted & m_prev_mask] = (dist <= m_window) ? len_t(dist) : 0;
+            m_head[h] = m_inserted + 1;
+        }
+    }
+
+public:
+    /// \brief Constructs an empty window.
+    ///
+    /// \param window The maximum distance of a match.
+    /// \param max_len The maximum length of a match, which also is the size
+    ///                of the lookahead.
+    /// \param min_len The minimum length of a match.
+    /// \param max_chain The maximum amount of positions to compare against.
+    /// \param nice_len The length of a match that stops the search.
+    inline SlidingWindow(size_t window, size_t max_len, size_t min_len,
+                         size_t max_chain, size_t nice_len)
+        : m_window(window),
+          m_max_len(max_len),
+          m_hash_len(std::max(size_t(1), std::min(min_len, size_t(HASH_LEN)))),
+          m_max_chain(max_chain),
+          m_nice_len(nice_len),
+          m_pos(0),
+          m_end(0),
+          m_inserted(0) {
+
+        DCHECK_GT(window, 0U);
+        DCHECK_GT(max_len, 0U);
+
+        m_buffer.resize(size_t(1) << bits_for(window + max_len - 1));
+        m_buffer_mask = m_buffer.size() - 1;
+
+        m_prev.resize(size_t(1) << bits_for(window - 1));
+        m_prev_mask = m_prev.size() - 1;
+
+        const size_t hash_bits = std::min(std::max(size_t(bits_for(window)) + 1,
+                                                   size_t(8)), size_t(20));
+        m_head.resize(size_t(1) << hash_bits, 0);
+        m_hash_shift = 32 - hash_bits;
+    }
+
+    /// Returns the position of the first literal of the lookahead.
+    inline size_t pos() const { return m_pos; }
+
+    /// Returns the amount of literals in the lookahead.
+    inline size_t lookahead() const { return m_end - m_pos; }
+
+    /// Tests whether another literal can be appended to the lookahead.
+    inline bool can_push() const { return lookahead() < m_max_len; }
+
+    /// Appends a literal to the lookahead.
+    inline void push(uliteral_t c) {
+        DCHECK(can_push());
+        m_buffer[m_end & m_buffer_mask] = c;
+        ++m_end;
+    }
+
+    /// Returns the first literal of the lookahead.
+    inline uliteral_t current() const {
+        DCHECK_GT(lookahead(), 0U);
+        return at(m_pos);
+    }
+
+    /// \brief Finds the longest previous occurrence of a prefix of the
+    ///        lookahead.
+    ///
+    /// The occurrence starts within the back buffer, but may overlap the
+    /// lookahead. Of equally long occurrences, the closest one is reported.
+    ///
+    /// \param src Receives the starting position of the occurrence.
+    /// \return The length of the occurrence, or zero if there is none of at
+    ///         least the minimum length.
+    inline size_t find(size_t& src) {
+        update();
+
+        const size_t max_len = lookahead();
+        if(max_len < m_hash_len) return 0;
+
+        const size_t limit = (m_pos > m_window) ? m_pos - m_window : 0;
+        const size_t nice_len = std::min(m_nice_len, max_len);
+
+        size_t best = 0;
+        size_t cand = m_head[hash(m_pos)];
+        if(cand == 0 || cand - 1 < limit) return 0;
+        --cand;
+
+        for(size_t chain = m_max_chain; chain > 0; --chain) {
+            // only compare candidates that could improve the match
+            if(at(cand + best) == at(m_pos + best)) {
+                size_t len = 0;
+                while(len < max_len && at(cand + len) == at(m_pos + len)) ++len;
+
+                if(len > best) {
+                    best = len;
+                    src = cand;
+                    if(best >= nice_len) break;
+                }
+            }
+
+            const len_t dist = m_prev[cand & m_prev_mask];
+            if(dist == 0 || cand - dist < limit) break;
+            cand -= dist;
+        }
+
+        return (best >= m_hash_len) ? best : 0;
+    }
+
+    /// Moves the given amount of literals from the lookahead to the back
+    /// buffer.
+    inline void advance(size_t num) {
+        DCHECK_LE(num, lookahead());
+        m_pos += num;
+    }
+};
+
+}} //ns
@@ -19,7 +19,7 @@ void decode_step(F next_code_callback,
     // "named" lambda function, used to reset the dictionary to its initial contents
     const auto reset_dictionary = [&] {
         dictionary.clear();
-        dictionary.reserve(reserve_dms);
+        dictionary.reserve(std::min(dms, reserve_dms));
 
         const long int minc = std::numeric_limits<uliteral_t>::min();
         const long int maxc = std::numeric_limits<uliteral_t>::max();
@@ -34,7 +34,7 @@ void decode_step(F next_code_callback,
         s.clear();
 
         // the length of a string cannot exceed the dictionary's number of entries
-        s.reserve(reserve_dms);
+        s.reserve(std::min(dms, reserve_dms));
 
         while (k != dms)
         {
@@ -57,11 +57,13 @@ void decode_step(F next_code_callback,
     {
         bool dictionary_reset = false;
 
-        // dictionary's maximum size was reached
-        if (dictionary.size() == dms)
+        // dictionary's maximum size is reached by the next code,
+        // which the compressor encoded after resetting its dictionary
+        if (dictionary.size() + 1 == dms)
         {
             reset_dictionary();
             dictionary_reset = true;
+            i = dms;
         }
 
         if (!next_code_callback(k, dictionary_reset, corrupted))
@@ -54,8 +54,15 @@
 #endif
 
 namespace tdc {
+// type used for text positions and lengths (default 32 bits)
+// (pass -DLEN_64=1 to CMake to process inputs larger than 4 GiB)
+#ifdef LEN_64
+    /// Type to represent input lengths.
+	typedef uint64_t len_t;
+#else
     /// Type to represent input lengths.
 	typedef uint32_t len_t;
+#endif
 
     /// The maximum value of \ref len_t.
 	constexpr size_t LEN_MAX = std::numeric_limits<len_t>::max();
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/util.hpp>
+#include <tudocomp/util/Hash.hpp>
+#include <tudocomp/util/external.hpp>
+
+namespace tdc {
+
+/// \brief Persistent on-disk cache for the arrays of a \ref TextDS.
+///
+/// Arrays are stored bit-compressed into files of a cache directory. The
+/// file names consist of a hash of the input text, its length, the name of
+/// the data structure and an identifier of the algorithms used to construct
+/// it, so a cached array is only reused for the same text and construction.
+class DSCache {
+private:
+    static constexpr uint64_t MAGIC = 0x0031534443544454ULL; // "TDTCDS1"
+
+    std::string m_dir;
+    std::string m_prefix; // text hash and length
+
+    inline static uint64_t hash(const View& text) {
+        MixHasher mix;
+        const size_t n = text.size();
+
+        uint64_t h = mix(n);
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, text.data() + i, 8);
+            h = mix(h ^ w);
+        }
+        for(; i < n; ++i) {
+            h = mix(h ^ uint64_t(text[i]));
+        }
+        return h;
+    }
+
+public:
+    /// Constructs a disabled cache.
+    inline DSCache() {}
+
+    /// Constructs a cache for the given text.
+    ///
+    /// \param dir The cache directory, which must exist.
+    /// \param text The input text.
+    inline DSCache(const std::string& dir, const View& text) : m_dir(dir) {
+        if(enabled()) {
+            std::ostringstream prefix;
+            prefix << std::hex << std::setw(16) << std::setfill('0')
+                   << hash(text) << std::dec << "-" << text.size();
+            m_prefix = prefix.str();
+        }
+    }
+
+    /// Tells whether the cache is enabled.
+    inline bool enabled() const {
+        return !m_dir.empty();
+    }
+
+    /// Returns the file path for a data structure.
+    ///
+    /// \param name The name of the data structure (e.g., \c sa).
+    /// \param id An identifier of the algorithms used to construct it.
+    inline std::string path(const std::string& name, const std::string& id) const {
+        return m_dir + "/" + m_prefix + "." + name + "-" + id + ".tdc";
+    }
+
+    /// Loads an array from the cache.
+    ///
+    /// \param path The file path as returned by \ref path.
+    /// \param iv The array to load into.
+    /// \return \e true if the array was found in the cache, \e false
+    ///         otherwise.
+    inline bool load(const std::string& path, DynamicIntVector& iv) const {
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if(!in) return false;
+
+        uint64_t header[3];
+        in.read((char*)header, sizeof(header));
+        if(!in || header[0] != MAGIC || header[2] == 0 || header[2] > 64) {
+            return false;
+        }
+
+        const size_t n = header[1];
+        const uint8_t w = header[2];
+
+        DynamicIntVector data(n, 0, w);
+        in.read((char*)data.data(), idiv_ceil(n * w, 64) * sizeof(uint64_t));
+        if(!in) return false;
+
+        iv = std::move(data);
+        return true;
+    }
+
+    /// Stores an array into the cache.
+    ///
+    /// The array is written bit-compressed to a temporary file that is
+    /// unique to this writer, which is renamed afterwards so that concurrent
+    /// runs never read incomplete files. Failures are reported, but do not abort the compression.
+    ///
+    /// \param path The file path as returned by \ref path.
+    /// \param iv The array to store.
+    inline void store(const std::string& path, const DynamicIntVector& iv) const {
+        const size_t n = iv.size();
+
+        size_t max = 0;
+        for(size_t i = 0; i < n; ++i) max = std::max(max, size_t(iv[i]));
+        const uint8_t w = bits_for(max);
+
+        // bit-compress a copy if required
+        DynamicIntVector packed;
+        const DynamicIntVector* src = &iv;
+        if(iv.width() != w) {
+            packed = DynamicIntVector(n, 0, w);
+            for(size_t i = 0; i < n; ++i) packed[i] = iv[i];
+            src = &packed;
+        }
+
+        // in the cache directory, so that the file can be renamed
+        const std::string tmp = external::scratch_path(m_dir, "tmp");
+        {
+            std::ofstream out(tmp, std::ios::out | std::ios::binary);
+
+            const uint64_t header[3] = { MAGIC, n, w };
+            out.write((const char*)header, sizeof(header));
+            out.write((const char*)src->data(), idiv_ceil(n * w, 64) * sizeof(uint64_t));
+
+            if(!out) {
+                LOG(WARNING) << "could not write " << tmp << " to the cache";
+                out.close();
+                std::remove(tmp.c_str());
+                return;
+            }
+        }
+
+        if(std::rename(tmp.c_str(), path.c_str()) != 0) {
+            LOG(WARNING) << "could not move " << tmp << " into the cache";
+            std::remove(tmp.c_str());
+        }
+    }
+};
+
+} //ns
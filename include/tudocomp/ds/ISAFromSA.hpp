@@ -45,6 +45,12 @@ public:
         if(cm == CompressMode::delayed) compress();
     }
 
+    /// Restores the inverse suffix array from previously constructed data.
+    inline ISAFromSA(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+    }
+
     void compress() {
         debug_check_array_is_initialized();
 
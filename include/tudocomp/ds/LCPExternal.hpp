@@ -0,0 +1,109 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/MMapArrayDS.hpp>
+#include <tudocomp/util/external.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the LCP array in semi-external memory using a sparse Phi array.
+///
+/// Only every q-th entry of the Phi and PLCP arrays is held in memory, with
+/// q chosen so that they fit into the given memory budget. The suffix array
+/// is only scanned sequentially, and since the PLCP value of a text position
+/// is at least that of the preceding sampled position minus their distance,
+/// every LCP value is computed from such a lower bound with O(q) additional
+/// character comparisons on average. The LCP array is written to a file in
+/// the scratch directory and accessed through a memory mapping.
+class LCPExternal: public Algorithm, public MMapArrayDS {
+private:
+    len_t m_max;
+
+public:
+    inline static Meta meta() {
+        Meta m("lcp", "external", "Semi-external construction using a sparse Phi array");
+        m.option("scratch").dynamic("/tmp");
+        m.option("budget").dynamic(1024);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    template<typename textds_t>
+    inline LCPExternal(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        const std::string& dir = this->env().option("scratch").as_string();
+        const size_t budget = this->env().option("budget").as_integer() << 20;
+
+        // Construct Suffix Array
+        auto& sa = t.require_sa(cm);
+
+        const size_t n = t.size();
+        const std::string path = external::scratch_path(dir, "lcp");
+
+        StatPhase::wrap("Construct LCP Array", [&]{
+            // choose the sampling rate so that the sparse array fits the budget
+            const size_t q = std::max(size_t(1), idiv_ceil(n * sizeof(len_t), budget));
+            const size_t m = idiv_ceil(n, q);
+
+            // Construct sparse Phi array
+            std::vector<len_t> sparse(m);
+            for(size_t i = 0; i < n; ++i) {
+                const size_t j = sa[i];
+                if(j % q == 0) sparse[j / q] = sa[(i > 0) ? i - 1 : n - 1];
+            }
+
+            // Compute sparse PLCP array in-place
+            for(size_t k = 0, l = 0; k < m; ++k) {
+                const size_t j = k * q;
+                if(j + 1 < n) {
+                    const size_t phij = sparse[k];
+                    while(t[j+l] == t[phij+l]) ++l;
+                } else {
+                    l = 0; // the sentinel suffix
+                }
+                sparse[k] = l;
+                l = (l > q) ? l - q : 0;
+            }
+
+            // Compute LCP array (written before its maximum is known)
+            const uint8_t bytes = bytes_for(n);
+
+            m_max = 0;
+            {
+                Writer lcp(path, bytes);
+
+                if(n > 0) lcp.write(0);
+                for(size_t i = 1; i < n; ++i) {
+                    const size_t j = sa[i];
+                    const size_t p = sa[i-1];
+
+                    const size_t d = j % q;
+                    size_t l = (sparse[j / q] > d) ? sparse[j / q] - d : 0;
+                    while(t[j+l] == t[p+l]) ++l;
+
+                    m_max = std::max(m_max, len_t(l));
+                    lcp.write(l);
+                }
+            }
+
+            map_array(path, n, bytes);
+
+            StatPhase::log("sampling", q);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+
+    inline len_t max_lcp() const {
+        return m_max;
+    }
+};
+
+} //ns
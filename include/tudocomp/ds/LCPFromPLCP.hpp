@@ -53,6 +53,17 @@ public:
         if(cm == CompressMode::delayed) compress();
     }
 
+    /// Restores the LCP array from previously constructed data.
+    inline LCPFromPLCP(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+
+        m_max = 0;
+        for(size_t i = 0; i < size(); ++i) {
+            m_max = std::max(m_max, len_t((*this)[i]));
+        }
+    }
+
 	inline len_t max_lcp() const {
 		return m_max;
 	}
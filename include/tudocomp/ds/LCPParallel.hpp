@@ -0,0 +1,91 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the LCP array from the PLCP array in parallel.
+class LCPParallel: public Algorithm, public ArrayDS {
+private:
+    len_t m_max;
+
+public:
+    inline static Meta meta() {
+        Meta m("lcp", "parallel", "Parallel construction from PLCP");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    template<typename textds_t>
+    inline LCPParallel(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        // Construct Suffix Array and PLCP Array
+        auto& sa = t.require_sa(cm);
+        auto& plcp = t.require_plcp(cm);
+
+        const size_t n = t.size();
+
+        StatPhase::wrap("Construct LCP Array", [&]{
+            // Compute LCP array
+            m_max = plcp.max_lcp();
+            const size_t w = bits_for(m_max);
+
+            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w : LEN_BITS));
+
+            parallel::for_blocks(threads, n, [&](size_t b, size_t e){
+                for(size_t i = std::max(b, size_t(1)); i < e; ++i) {
+                    (*this)[i] = plcp[sa[i]];
+                }
+            }, 64);
+            (*this)[0] = 0;
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::delayed) compress();
+    }
+
+    /// Restores the LCP array from previously constructed data.
+    inline LCPParallel(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+
+        m_max = 0;
+        for(size_t i = 0; i < size(); ++i) {
+            m_max = std::max(m_max, len_t((*this)[i]));
+        }
+    }
+
+	inline len_t max_lcp() const {
+		return m_max;
+	}
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress LCP Array", [this]{
+            width(bits_for(m_max));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/util.hpp>
+
+namespace tdc {
+
+/// \brief Base for data structures that keep their integer array in a file.
+///
+/// The array is stored in a scratch file with a fixed amount of bytes per
+/// entry and accessed through a memory mapping of that file, so the
+/// operating system can page it in and out as needed instead of holding it
+/// in RAM. The file itself is never modified: the mapping is private, i.e.,
+/// entries overwritten by consumers (e.g., lcpcomp strategies working on the
+/// LCP array) are copied into memory page by page. The file is removed when
+/// the data structure is destroyed.
+class MMapArrayDS {
+public:
+    /// \brief The type of integer array that the data can be copied into.
+    using iv_t = DynamicIntVector;
+
+    /// \brief The data structure's data type.
+    using data_type = iv_t;
+
+    /// \brief Writes an array file sequentially.
+    class Writer {
+    private:
+        std::ofstream m_out;
+        std::vector<uint8_t> m_buffer;
+        size_t m_pos;
+        uint8_t m_bytes;
+
+    public:
+        /// Creates (or truncates) the file at the given path.
+        ///
+        /// \param path The file path.
+        /// \param bytes The amount of bytes per entry.
+        /// \param buffer_bytes The size of the write buffer in bytes.
+        inline Writer(const std::string& path, uint8_t bytes, size_t buffer_bytes = 1ULL << 20)
+            : m_out(path, std::ios::out | std::ios::binary | std::ios::trunc),
+              m_buffer(std::max(buffer_bytes, size_t(16))),
+              m_pos(0),
+              m_bytes(bytes) {
+
+            CHECK(m_out) << "could not create " << path;
+        }
+
+        inline ~Writer() {
+            flush();
+        }
+
+        /// Appends an entry.
+        inline void write(uint64_t v) {
+            // entries are stored little endian
+            std::memcpy(m_buffer.data() + m_pos, &v, m_bytes);
+            m_pos += m_bytes;
+            if(m_pos + m_bytes > m_buffer.size()) flush();
+        }
+
+        /// Writes all buffered entries to the file.
+        inline void flush() {
+            m_out.write((const char*)m_buffer.data(), m_pos);
+            CHECK(m_out) << "could not write array file";
+            m_out.flush();
+            m_pos = 0;
+        }
+    };
+
+    /// \brief Reference to an entry of the array.
+    class Ref {
+    private:
+        uint8_t* m_ptr;
+        uint8_t m_bytes;
+
+    public:
+        inline Ref(uint8_t* ptr, uint8_t bytes) : m_ptr(ptr), m_bytes(bytes) {}
+
+        inline operator len_t() const {
+            uint64_t v = 0;
+            std::memcpy(&v, m_ptr, m_bytes);
+            return v;
+        }
+
+        inline Ref& operator=(uint64_t v) {
+            std::memcpy(m_ptr, &v, m_bytes);
+            return *this;
+        }
+
+        inline Ref& operator=(const Ref& other) {
+            return (*this = uint64_t(len_t(other)));
+        }
+    };
+
+private:
+    std::string m_path;
+    uint8_t* m_data;
+    size_t m_size;
+    uint8_t m_bytes;
+
+    inline void unmap() {
+        if(m_data) {
+            munmap(m_data, m_size * m_bytes);
+            m_data = nullptr;
+        }
+        if(!m_path.empty()) {
+            std::remove(m_path.c_str());
+            m_path.clear();
+        }
+        m_size = 0;
+    }
+
+    inline void move_from(MMapArrayDS&& other) {
+        m_path = std::move(other.m_path);
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_bytes = other.m_bytes;
+
+        other.m_path.clear();
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+protected:
+    /// \brief Maps an array file written by a \ref Writer.
+    ///
+    /// The data structure takes ownership of the file.
+    ///
+    /// \param path The file path.
+    /// \param n The amount of entries.
+    /// \param bytes The amount of bytes per entry.
+    inline void map_array(const std::string& path, size_t n, uint8_t bytes) {
+        unmap();
+
+        m_path = path;
+        m_size = n;
+        m_bytes = bytes;
+
+        if(n > 0) {
+            const int fd = open(path.c_str(), O_RDONLY);
+            CHECK(fd != -1) << "could not open " << path;
+
+            void* ptr = mmap(NULL, n * bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+
+            CHECK(ptr != MAP_FAILED) << "could not map " << path;
+            m_data = (uint8_t*)ptr;
+        }
+    }
+
+public:
+    inline MMapArrayDS() : m_data(nullptr), m_size(0), m_bytes(0) {}
+
+    inline ~MMapArrayDS() {
+        unmap();
+    }
+
+    inline MMapArrayDS(const MMapArrayDS& other) = delete;
+    inline MMapArrayDS(MMapArrayDS&& other) {
+        move_from(std::move(other));
+    }
+    inline MMapArrayDS& operator=(MMapArrayDS&& other) {
+        unmap();
+        move_from(std::move(other));
+        return *this;
+    }
+
+    /// \brief Accesses the entry at position i.
+    inline len_t operator[](size_t i) const {
+        DCHECK_LT(i, m_size);
+        uint64_t v = 0;
+        std::memcpy(&v, m_data + i * m_bytes, m_bytes);
+        return v;
+    }
+
+    /// \brief Accesses the entry at position i for writing.
+    inline Ref operator[](size_t i) {
+        DCHECK_LT(i, m_size);
+        return Ref(m_data + i * m_bytes, m_bytes);
+    }
+
+    /// \brief Returns the amount of entries.
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// \brief Returns the bit width of an entry.
+    inline uint8_t width() const {
+        return 8 * m_bytes;
+    }
+
+    /// \brief Returns the size of the array in bits.
+    inline size_t bit_size() const {
+        return m_size * width();
+    }
+
+    /// \brief Returns the path of the array file.
+    inline const std::string& path() const {
+        return m_path;
+    }
+
+    /// \brief Does nothing, since the array is already stored with the
+    ///        least amount of bytes per entry.
+    inline void compress() {
+    }
+
+    /// \brief Forces the data structure to relinquish its data.
+    ///
+    /// The array is loaded into memory and the file is removed.
+    inline iv_t relinquish() {
+        iv_t data = copy();
+        unmap();
+        return data;
+    }
+
+    /// \brief Creates a copy of the array in memory.
+    inline iv_t copy() const {
+        iv_t data(m_size, 0, std::max(uint8_t(1), width()));
+        for(size_t i = 0; i < m_size; ++i) data[i] = (*this)[i];
+        return data;
+    }
+};
+
+} //ns
@@ -52,6 +52,17 @@ public:
         }
     }
 
+    /// Restores the PLCP array from previously constructed data.
+    inline PLCPFromPhi(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+
+        m_max = 0;
+        for(size_t i = 0; i < size(); ++i) {
+            m_max = std::max(m_max, len_t((*this)[i]));
+        }
+    }
+
 	inline len_t max_lcp() const {
 		return m_max;
 	}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the PLCP array using the phi array in parallel.
+///
+/// The text positions are split into one contiguous range per thread, and
+/// each range runs the Phi algorithm on its own. Since the algorithm only
+/// needs a lower bound for the first value, every range simply starts over
+/// at zero, which costs at most one additional LCP length per thread. The
+/// ranges are aligned to words of the storage, so the Phi array can still be
+/// overwritten in-place.
+class PLCPParallel: public Algorithm, public ArrayDS {
+private:
+    len_t m_max;
+
+public:
+    inline static Meta meta() {
+        Meta m("plcp", "parallel", "Parallel construction from Phi");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    template<typename textds_t>
+    inline PLCPParallel(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        const size_t n = t.size();
+
+        // Construct Phi and attempt to work in-place
+        set_array(t.inplace_phi(cm));
+
+        StatPhase::wrap("Construct PLCP Array", [&]{
+            // Use Phi algorithm on each range to compute PLCP array
+            std::vector<len_t> max(threads, 0);
+
+            // ranges are multiples of 64 entries so they never share a word
+            const size_t m = n - 1;
+            const size_t block = idiv_ceil(idiv_ceil(m, 64), threads) * 64;
+
+            parallel::run(threads, [&](size_t tid){
+                const size_t b = std::min(m, tid * block);
+                const size_t e = std::min(m, b + block);
+
+                len_t local_max = 0;
+                for(len_t i = b, l = 0; i < e; ++i) {
+                    const len_t phii = (*this)[i];
+                    while(t[i+l] == t[phii+l]) ++l;
+                    local_max = std::max(local_max, l);
+                    (*this)[i] = l;
+                    if(l) --l;
+                }
+                max[tid] = local_max;
+            });
+
+            m_max = *std::max_element(max.begin(), max.end());
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+            compress();
+        }
+    }
+
+    /// Restores the PLCP array from previously constructed data.
+    inline PLCPParallel(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+
+        m_max = 0;
+        for(size_t i = 0; i < size(); ++i) {
+            m_max = std::max(m_max, len_t((*this)[i]));
+        }
+    }
+
+	inline len_t max_lcp() const {
+		return m_max;
+	}
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress PLCP Array", [this]{
+            width(bits_for(m_max));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the previous smaller value array of the suffix array.
+///
+/// Entry \c i holds the greatest index <tt>j < i</tt> with
+/// <tt>SA[j] < SA[i]</tt>, or the text length if there is none. Each entry
+/// is found by following the previous smaller values starting at
+/// <tt>i - 1</tt>, which takes linear time in total.
+class PSVFromSA: public Algorithm, public ArrayDS {
+public:
+    inline static Meta meta() {
+        Meta m("psv", "from_sa");
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    template<typename textds_t>
+    inline PSVFromSA(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        // Require Suffix Array
+        auto& sa = t.require_sa(cm);
+
+        StatPhase::wrap("Construct PSV Array", [&]{
+            // Allocate
+            const size_t n = t.size();
+            const size_t w = bits_for(n);
+            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w : LEN_BITS));
+
+            // Construct
+            for(len_t i = 0; i < n; i++) {
+                const len_t x = sa[i];
+
+                len_t j = (i > 0) ? i - 1 : n;
+                while(j < n && len_t(sa[j]) > x) j = (*this)[j];
+                (*this)[i] = j;
+            }
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::delayed) compress();
+    }
+
+    /// Restores the PSV array from previously constructed data.
+    inline PSVFromSA(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+    }
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress PSV Array", [this]{
+            width(bits_for(size()));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
@@ -47,6 +47,12 @@ public:
         if(cm == CompressMode::delayed) compress();
     }
 
+    /// Restores the Phi array from previously constructed data.
+    inline PhiFromSA(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+    }
+
     void compress() {
         debug_check_array_is_initialized();
 
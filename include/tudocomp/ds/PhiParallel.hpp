@@ -0,0 +1,86 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the Phi array using the suffix array in parallel.
+///
+/// Every thread processes a contiguous range of the suffix array. Because
+/// the resulting writes are scattered across the whole array, they go into
+/// a plain buffer first, which is then copied into the bit-compressed
+/// storage in blocks that never share a word.
+class PhiParallel: public Algorithm, public ArrayDS {
+public:
+    inline static Meta meta() {
+        Meta m("phi", "parallel", "Parallel construction from the SA");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    template<typename textds_t>
+    inline PhiParallel(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        // Construct Suffix Array
+        auto& sa = t.require_sa(cm);
+
+        const size_t n = t.size();
+        const size_t w = bits_for(n);
+
+        StatPhase::wrap("Construct Phi Array", [&]{
+            std::vector<len_t> phi(n);
+
+            parallel::for_blocks(threads, n, [&](size_t b, size_t e){
+                for(size_t i = std::max(b, size_t(1)); i < e; ++i) {
+                    phi[sa[i]] = sa[i-1];
+                }
+            });
+            phi[sa[0]] = sa[n-1];
+
+            // Copy into bit-compressed storage
+            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w : LEN_BITS));
+            parallel::for_blocks(threads, n, [&](size_t b, size_t e){
+                for(size_t i = b; i < e; ++i) (*this)[i] = phi[i];
+            }, 64);
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::delayed) compress();
+    }
+
+    /// Restores the Phi array from previously constructed data.
+    inline PhiParallel(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+    }
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress Phi Array", [this]{
+            width(bits_for(size()));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
@@ -48,6 +48,12 @@ public:
         }
     }
 
+    /// Restores the suffix array from previously constructed data.
+    inline SADivSufSort(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+    }
+
     void compress() {
         debug_check_array_is_initialized();
 
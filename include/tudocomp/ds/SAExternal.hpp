@@ -0,0 +1,304 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/MMapArrayDS.hpp>
+#include <tudocomp/util/external.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the suffix array in external memory using prefix doubling
+/// with discarding (see [Dementiev et al., 2008]).
+///
+/// The suffixes are first sorted by their initial eight characters. Every
+/// suffix is ranked by the position of the first suffix with the same
+/// prefix in the suffix array. In each following round, the rank of every
+/// suffix whose rank is not unique yet is paired with the rank of the suffix
+/// h positions further right, and the pairs are sorted to refine the ranks
+/// to the first 2h characters. Suffixes with unique ranks keep them and are
+/// not sorted again. When all ranks are unique, they are sorted into the
+/// suffix array.
+///
+/// All sorting is done by an external sorter that keeps at most the given
+/// memory budget in RAM and stores everything else in the scratch
+/// directory. The ranks are kept in a file in text order. The resulting
+/// suffix array is written to a file there as well and accessed through a
+/// memory mapping.
+class SAExternal: public Algorithm, public MMapArrayDS {
+private:
+    // number of characters that are compared in the first round
+    static constexpr size_t INITIAL_DEPTH = 8;
+
+    // buffer size for sequential file access
+    static constexpr size_t IO_BUFFER = 1ULL << 20;
+
+    struct initial_t {
+        uint64_t key;
+        len_t i;
+    };
+
+    struct pair_t {
+        len_t r1, r2;
+        len_t i;
+    };
+
+    // the rank of a suffix, which is zero for positions beyond the text
+    struct rank_t {
+        len_t rank;
+        bool unique;
+    };
+
+    // the new rank of suffix i
+    struct update_t {
+        len_t i;
+        rank_t rank;
+    };
+
+    // a suffix with its final rank
+    struct suffix_t {
+        len_t rank;
+        len_t i;
+    };
+
+    struct initial_less {
+        inline bool operator()(const initial_t& a, const initial_t& b) const {
+            return a.key < b.key;
+        }
+    };
+
+    struct pair_less {
+        inline bool operator()(const pair_t& a, const pair_t& b) const {
+            return a.r1 < b.r1 || (a.r1 == b.r1 && a.r2 < b.r2);
+        }
+    };
+
+    struct update_less {
+        inline bool operator()(const update_t& a, const update_t& b) const {
+            return a.i < b.i;
+        }
+    };
+
+    struct suffix_less {
+        inline bool operator()(const suffix_t& a, const suffix_t& b) const {
+            return a.rank < b.rank;
+        }
+    };
+
+    using update_sorter_t = external::ExternalSorter<update_t, update_less>;
+
+    template<typename T>
+    inline static T read(external::BufferedReader<T>& in) {
+        T x;
+        const bool ok = in.next(x);
+        CHECK(ok) << "unexpected end of scratch file";
+        return x;
+    }
+
+    /// Assigns new ranks to sorted suffixes.
+    ///
+    /// Every suffix gets the suffix array position of the first suffix with
+    /// the same key plus one, because zero is reserved for positions beyond
+    /// the text. The new ranks are passed to the given sorter, so they can
+    /// be brought into text order.
+    ///
+    /// \param pos Returns the suffix array position of the k-th suffix,
+    ///            called as \c pos(x, k) for the first suffix of each key.
+    /// \return The amount of suffixes whose rank is not unique.
+    template<typename sorter_t, typename equal_t, typename pos_t>
+    inline static size_t assign_ranks(
+        sorter_t& sorter, equal_t equal, pos_t pos, update_sorter_t& updates) {
+
+        size_t unfinished = 0;
+        size_t k = 0;
+        typename sorter_t::value_type prev;
+
+        // the first suffix of the current key is only passed on when it is
+        // known whether it is the only one
+        bool pending = false;
+        update_t first;
+
+        sorter.sorted([&](const typename sorter_t::value_type& x){
+            if(k == 0 || !equal(prev, x)) {
+                if(pending) updates.push(first);
+                first = update_t { x.i, rank_t { len_t(pos(x, k) + 1), true } };
+                pending = true;
+            } else {
+                if(pending) {
+                    first.rank.unique = false;
+                    updates.push(first);
+                    pending = false;
+                    ++unfinished;
+                }
+                updates.push(update_t { x.i, rank_t { first.rank.rank, false } });
+                ++unfinished;
+            }
+
+            prev = x;
+            ++k;
+        });
+
+        if(pending) updates.push(first);
+        return unfinished;
+    }
+
+    /// Writes the ranks in text order to a file, replacing the ranks of
+    /// the given suffixes in the previous file, if any.
+    inline static void write_ranks(
+        update_sorter_t& updates, const std::string& prev_path,
+        const std::string& path, size_t n) {
+
+        external::BufferedWriter<rank_t> out(path, IO_BUFFER);
+
+        if(prev_path.empty()) {
+            updates.sorted([&](const update_t& u){ out.write(u.rank); });
+        } else {
+            external::BufferedReader<rank_t> prev(prev_path, IO_BUFFER);
+
+            size_t i = 0;
+            updates.sorted([&](const update_t& u){
+                for(; i < u.i; ++i) out.write(read(prev));
+                read(prev);
+                out.write(u.rank);
+                ++i;
+            });
+            for(; i < n; ++i) out.write(read(prev));
+        }
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("sa", "external", "External memory prefix doubling");
+        m.option("scratch").dynamic("/tmp");
+        m.option("budget").dynamic(1024);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {
+            { 0 },
+            true
+        };
+    }
+
+    template<typename textds_t>
+    inline SAExternal(Env&& env, const textds_t& t, CompressMode)
+        : Algorithm(std::move(env)) {
+
+        const std::string& dir = this->env().option("scratch").as_string();
+
+        // the budget is shared by the sorter being read and the one being filled
+        const size_t budget = (this->env().option("budget").as_integer() << 20) / 2;
+
+        const size_t n = t.size();
+        const uint8_t bytes = bytes_for(n);
+
+        const std::string sa_path = external::scratch_path(dir, "sa");
+        const std::string rank_path = external::scratch_path(dir, "rank");
+
+        StatPhase::wrap("Construct SA", [&]{
+            size_t rounds = 1;
+
+            // sort by the initial characters
+            size_t unfinished = StatPhase::wrap("Initial Round", [&]{
+                update_sorter_t updates(dir, budget);
+                size_t remaining;
+                {
+                    external::ExternalSorter<initial_t, initial_less> sorter(dir, budget);
+                    for(size_t i = 0; i < n; ++i) {
+                        uint64_t key = 0;
+                        for(size_t k = 0; k < INITIAL_DEPTH; ++k) {
+                            key = (key << 8) | ((i + k < n) ? uint64_t(t[i + k]) : 0);
+                        }
+                        sorter.push(initial_t { key, len_t(i) });
+                    }
+
+                    remaining = assign_ranks(sorter,
+                        [](const initial_t& a, const initial_t& b) {
+                            return a.key == b.key;
+                        },
+                        [](const initial_t&, size_t k) { return k; },
+                        updates);
+                }
+
+                write_ranks(updates, "", rank_path, n);
+
+                StatPhase::log("unfinished", remaining);
+                return remaining;
+            });
+
+            // prefix doubling
+            for(size_t h = INITIAL_DEPTH; unfinished > 0; h *= 2, ++rounds) {
+                unfinished = StatPhase::wrap("Doubling Round", [&]{
+                    update_sorter_t updates(dir, budget);
+                    size_t remaining;
+                    {
+                        // pair up the ranks of suffixes i and i+h, unless
+                        // the rank of suffix i is unique
+                        external::ExternalSorter<pair_t, pair_less> sorter(dir, budget);
+                        {
+                            external::BufferedReader<rank_t> r1(rank_path, IO_BUFFER);
+                            external::BufferedReader<rank_t> r2(rank_path, IO_BUFFER, h);
+
+                            for(size_t i = 0; i < n; ++i) {
+                                const rank_t a = read(r1);
+                                const len_t b = (i + h < n) ? read(r2).rank : 0;
+                                if(!a.unique) sorter.push(pair_t { a.rank, b, len_t(i) });
+                            }
+                        }
+
+                        // the suffixes with rank r1 take the suffix array
+                        // positions from r1 - 1 on
+                        len_t block_rank = 0;
+                        size_t block_start = 0;
+
+                        remaining = assign_ranks(sorter,
+                            [](const pair_t& a, const pair_t& b) {
+                                return a.r1 == b.r1 && a.r2 == b.r2;
+                            },
+                            [&](const pair_t& x, size_t k) {
+                                if(k == 0 || x.r1 != block_rank) {
+                                    block_rank = x.r1;
+                                    block_start = k;
+                                }
+                                return size_t(x.r1 - 1) + (k - block_start);
+                            },
+                            updates);
+                    }
+
+                    const std::string next_path = external::scratch_path(dir, "rank");
+                    write_ranks(updates, rank_path, next_path, n);
+                    std::remove(rank_path.c_str());
+                    std::rename(next_path.c_str(), rank_path.c_str());
+
+                    StatPhase::log("unfinished", remaining);
+                    return remaining;
+                });
+            }
+
+            // sort the suffixes by their ranks
+            StatPhase::wrap("Write SA", [&]{
+                external::ExternalSorter<suffix_t, suffix_less> sorter(dir, budget);
+                {
+                    external::BufferedReader<rank_t> ranks(rank_path, IO_BUFFER);
+                    for(size_t i = 0; i < n; ++i) {
+                        sorter.push(suffix_t { read(ranks).rank, len_t(i) });
+                    }
+                }
+                std::remove(rank_path.c_str());
+
+                Writer sa(sa_path, bytes, IO_BUFFER);
+                sorter.sorted([&](const suffix_t& x){ sa.write(x.i); });
+            });
+
+            map_array(sa_path, n, bytes);
+
+            StatPhase::log("rounds", rounds);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
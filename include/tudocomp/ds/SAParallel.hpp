@@ -0,0 +1,254 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the suffix array in parallel using prefix doubling.
+///
+/// The suffixes are first bucket sorted by their first two characters.
+/// Afterwards, the groups of suffixes sharing the same prefix of length h
+/// are refined by sorting them by the rank of the suffix h positions
+/// further (Larsson and Sadakane), doubling h in every round until all
+/// groups are singletons. Groups are processed by different threads, very
+/// large groups are sorted by all threads together.
+///
+/// Requires the input to be terminated by a unique sentinel, so that no
+/// rank lookup ever reaches past the end of the text.
+class SAParallel: public Algorithm, public ArrayDS {
+private:
+    typedef std::pair<len_t, len_t> group_t; // [begin, end)
+    typedef std::pair<len_t, len_t> entry_t; // (key, text position)
+
+    static constexpr size_t KEY_BITS = 16;
+    static constexpr size_t NUM_KEYS = size_t(1) << KEY_BITS;
+
+    template<typename text_t>
+    inline static size_t initial_key(const text_t& t, size_t n, size_t i) {
+        return (size_t(t[i]) << 8) | ((i + 1 < n) ? size_t(t[i+1]) : 0);
+    }
+
+    /// Computes the suffix array into sa, using rank as working space.
+    /// After construction, rank contains the inverse suffix array.
+    template<typename text_t>
+    inline static void construct(
+        const text_t& t, const size_t n,
+        std::vector<len_t>& sa, std::vector<len_t>& rank,
+        const size_t threads, size_t& num_rounds) {
+
+        // bucket sort by the first two characters
+        std::vector<len_t> hist(threads * NUM_KEYS, 0);
+        std::vector<len_t> bucket_end(NUM_KEYS);
+
+        parallel::run(threads, [&](size_t tid){
+            len_t* h = hist.data() + tid * NUM_KEYS;
+            const size_t b = (n * tid) / threads, e = (n * (tid+1)) / threads;
+            for(size_t i = b; i < e; ++i) ++h[initial_key(t, n, i)];
+        });
+
+        std::vector<group_t> groups;
+        {
+            len_t sum = 0;
+            for(size_t c = 0; c < NUM_KEYS; ++c) {
+                const len_t begin = sum;
+                for(size_t tid = 0; tid < threads; ++tid) {
+                    const len_t count = hist[tid * NUM_KEYS + c];
+                    hist[tid * NUM_KEYS + c] = sum;
+                    sum += count;
+                }
+                bucket_end[c] = sum;
+                if(sum - begin > 1) groups.emplace_back(begin, sum);
+            }
+        }
+
+        parallel::run(threads, [&](size_t tid){
+            len_t* h = hist.data() + tid * NUM_KEYS;
+            const size_t b = (n * tid) / threads, e = (n * (tid+1)) / threads;
+            for(size_t i = b; i < e; ++i) {
+                const size_t c = initial_key(t, n, i);
+                sa[h[c]++] = i;
+                rank[i] = bucket_end[c] - 1;
+            }
+        });
+
+        hist = std::vector<len_t>();
+        bucket_end = std::vector<len_t>();
+
+        // refine unsorted groups by prefix doubling
+        std::vector<entry_t> buffer;
+        std::vector<group_t> next;
+        std::vector<size_t> part(threads + 1);
+        std::vector<size_t> next_count(threads);
+
+        num_rounds = 0;
+        for(size_t h = 2; !groups.empty(); h *= 2) {
+            ++num_rounds;
+
+            // compute buffer offsets of groups and split them into
+            // contiguous parts of roughly equal size
+            std::vector<size_t> offset(groups.size() + 1);
+            offset[0] = 0;
+            for(size_t g = 0; g < groups.size(); ++g) {
+                offset[g+1] = offset[g] + (groups[g].second - groups[g].first);
+            }
+
+            const size_t total = offset.back();
+            const size_t large = std::max(total / threads, size_t(1024));
+
+            part[0] = 0;
+            for(size_t tid = 1, g = 0; tid <= threads; ++tid) {
+                const size_t bound = (total * tid) / threads;
+                while(g < groups.size() && offset[g] < bound) ++g;
+                part[tid] = g;
+            }
+            part[threads] = groups.size();
+
+            buffer.resize(total);
+            next.resize(total / 2 + threads);
+
+            // fill keys and sort groups of moderate size
+            parallel::run(threads, [&](size_t tid){
+                for(size_t g = part[tid]; g < part[tid+1]; ++g) {
+                    const group_t& grp = groups[g];
+                    entry_t* buf = buffer.data() + offset[g];
+
+                    for(size_t j = grp.first; j < grp.second; ++j) {
+                        const size_t pos = sa[j];
+                        DCHECK_LT(pos + h, n);
+                        *buf++ = entry_t(rank[pos + h], pos);
+                    }
+
+                    if(grp.second - grp.first < large) {
+                        std::sort(buffer.data() + offset[g], buf,
+                            [](const entry_t& a, const entry_t& b){
+                                return a.first < b.first; });
+                    }
+                }
+            });
+
+            // sort large groups using all threads
+            for(size_t g = 0; g < groups.size(); ++g) {
+                if(groups[g].second - groups[g].first >= large) {
+                    parallel::sort(
+                        buffer.data() + offset[g], buffer.data() + offset[g+1],
+                        [](const entry_t& a, const entry_t& b){
+                            return a.first < b.first; },
+                        threads);
+                }
+            }
+
+            // write back sorted groups, update ranks and gather the groups
+            // that are still unsorted (a part of m entries yields at most
+            // m/2 of them, so every part gets a disjoint output region)
+            parallel::run(threads, [&](size_t tid){
+                group_t* out = next.data() + offset[part[tid]] / 2 + tid;
+                size_t count = 0;
+
+                for(size_t g = part[tid]; g < part[tid+1]; ++g) {
+                    const group_t& grp = groups[g];
+                    const entry_t* buf = buffer.data() + offset[g];
+                    const size_t size = grp.second - grp.first;
+
+                    for(size_t j = 0; j < size;) {
+                        // find subgroup of equal keys
+                        size_t k = j + 1;
+                        while(k < size && buf[k].first == buf[j].first) ++k;
+
+                        const len_t r = grp.first + k - 1;
+                        for(size_t x = j; x < k; ++x) {
+                            sa[grp.first + x] = buf[x].second;
+                            rank[buf[x].second] = r;
+                        }
+
+                        if(k - j > 1) {
+                            out[count++] = group_t(grp.first + j, grp.first + k);
+                        }
+                        j = k;
+                    }
+                }
+                next_count[tid] = count;
+            });
+
+            // compact the unsorted groups for the next round
+            groups.clear();
+            for(size_t tid = 0; tid < threads; ++tid) {
+                const group_t* out = next.data() + offset[part[tid]] / 2 + tid;
+                groups.insert(groups.end(), out, out + next_count[tid]);
+            }
+        }
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("sa", "parallel", "Parallel prefix doubling");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {
+            { 0 },
+            true
+        };
+    }
+
+    template<typename textds_t>
+    inline SAParallel(Env&& env, const textds_t& t, CompressMode cm)
+        : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        StatPhase::wrap("Construct SA", [&]{
+            const size_t n = t.size();
+            const size_t w = bits_for(n);
+
+            std::vector<len_t> sa(n);
+            std::vector<len_t> rank(n);
+
+            size_t num_rounds = 0;
+            construct(t, n, sa, rank, threads, num_rounds);
+            rank = std::vector<len_t>();
+
+            // Copy into bit-compressed storage
+            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w : LEN_BITS));
+            parallel::for_blocks(threads, n, [&](size_t b, size_t e){
+                for(size_t i = b; i < e; ++i) (*this)[i] = sa[i];
+            }, 64);
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("rounds", num_rounds);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+            compress();
+        }
+    }
+
+    /// Restores the suffix array from previously constructed data.
+    inline SAParallel(Env&& env, iv_t&& data)
+            : Algorithm(std::move(env)) {
+        set_array(std::move(data));
+    }
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress SA", [this]{
+            width(bits_for(size()));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
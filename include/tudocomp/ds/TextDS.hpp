@@ -4,7 +4,9 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/IntVector.hpp>
 
+#include <tudocomp/ds/ArrayDS.hpp>
 #include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/DSCache.hpp>
 
 //Defaults
 #include <tudocomp/ds/SADivSufSort.hpp>
@@ -12,6 +14,8 @@
 #include <tudocomp/ds/PLCPFromPhi.hpp>
 #include <tudocomp/ds/LCPFromPLCP.hpp>
 #include <tudocomp/ds/ISAFromSA.hpp>
+#include <tudocomp/ds/PSVFromSA.hpp>
+#include <tudocomp/ds/NSVFromSA.hpp>
 
 namespace tdc {
 
@@ -25,7 +29,9 @@ template<
     typename phi_t = PhiFromSA,
     typename plcp_t = PLCPFromPhi,
     typename lcp_t = LCPFromPLCP,
-    typename isa_t = ISAFromSA
+    typename isa_t = ISAFromSA,
+    typename psv_t = PSVFromSA,
+    typename nsv_t = NSVFromSA
 >
 class TextDS : public Algorithm {
 public:
@@ -35,6 +41,8 @@ public:
     static const dsflags_t LCP = ds::LCP;
     static const dsflags_t PHI = ds::PHI;
     static const dsflags_t PLCP = ds::PLCP;
+    static const dsflags_t PSV = ds::PSV;
+    static const dsflags_t NSV = ds::NSV;
 
     using value_type = uliteral_t;
 
@@ -43,6 +51,8 @@ public:
     using plcp_type = plcp_t;
     using lcp_type = lcp_t;
     using isa_type = isa_t;
+    using psv_type = psv_t;
+    using nsv_type = nsv_t;
 
     inline static ds::InputRestrictions common_restrictions(dsflags_t flags) {
         ds::InputRestrictions rest;
@@ -52,12 +62,14 @@ public:
         if (flags & LCP)  rest |= lcp_type::restrictions();
         if (flags & PHI)  rest |= phi_type::restrictions();
         if (flags & PLCP) rest |= plcp_type::restrictions();
+        if (flags & PSV)  rest |= psv_type::restrictions();
+        if (flags & NSV)  rest |= nsv_type::restrictions();
 
         return rest;
     };
 
 private:
-    using this_t = TextDS<sa_t, phi_t, plcp_t, lcp_t, isa_t>;
+    using this_t = TextDS<sa_t, phi_t, plcp_t, lcp_t, isa_t, psv_t, nsv_t>;
 
     View m_text;
 
@@ -66,16 +78,75 @@ private:
     std::unique_ptr<plcp_t> m_plcp;
     std::unique_ptr<lcp_t> m_lcp;
     std::unique_ptr<isa_t> m_isa;
+    std::unique_ptr<psv_t> m_psv;
+    std::unique_ptr<nsv_t> m_nsv;
 
     dsflags_t m_ds_requested;
     CompressMode m_cm;
 
+    DSCache m_cache;
+
+    // identifies the algorithms that a data structure is constructed with
+    inline std::string cache_id(const std::string& option) {
+        static const std::map<std::string, std::vector<std::string>> deps = {
+            {"sa",   {"sa"}},
+            {"phi",  {"sa", "phi"}},
+            {"plcp", {"sa", "phi", "plcp"}},
+            {"lcp",  {"sa", "phi", "plcp", "lcp"}},
+            {"isa",  {"sa", "isa"}},
+            {"psv",  {"sa", "psv"}},
+            {"nsv",  {"sa", "nsv"}},
+        };
+
+        std::string id;
+        for(auto& dep : deps.at(option)) {
+            if(!id.empty()) id += "_";
+            id += env().option(dep).as_algorithm().name();
+        }
+        return id;
+    }
+
     template<typename ds_t>
     inline std::unique_ptr<ds_t> construct_ds(const std::string& option, CompressMode cm) {
-        return std::make_unique<ds_t>(
-                    env().env_for_option(option),
-                    *this,
-                    cm_select(cm, m_cm));
+        cm = cm_select(cm, m_cm);
+
+        if(!m_cache.enabled()) {
+            return std::make_unique<ds_t>(env().env_for_option(option), *this, cm);
+        }
+        return construct_cached<ds_t>(option, cm, std::is_base_of<ArrayDS, ds_t>());
+    }
+
+    // data structures that are not held in memory are not cached
+    template<typename ds_t>
+    inline std::unique_ptr<ds_t> construct_cached(
+        const std::string& option, CompressMode cm, std::false_type) {
+
+        return std::make_unique<ds_t>(env().env_for_option(option), *this, cm);
+    }
+
+    template<typename ds_t>
+    inline std::unique_ptr<ds_t> construct_cached(
+        const std::string& option, CompressMode cm, std::true_type) {
+
+        // attempt to load from the cache
+        const std::string path = m_cache.path(option, cache_id(option));
+
+        std::unique_ptr<ds_t> p;
+        StatPhase::wrap("Load from Cache", [&]{
+            typename ds_t::data_type data;
+            if(m_cache.load(path, data)) {
+                // cached arrays are bit-compressed
+                if(cm == CompressMode::plain) data.width(LEN_BITS);
+                p = std::make_unique<ds_t>(env().env_for_option(option), std::move(data));
+            }
+            StatPhase::log("hit", bool(p));
+        });
+
+        if(!p) {
+            p = std::make_unique<ds_t>(env().env_for_option(option), *this, cm);
+            StatPhase::wrap("Store to Cache", [&]{ m_cache.store(path, *p); });
+        }
+        return p;
     }
 
     template<typename ds_t>
@@ -121,7 +192,10 @@ public:
         m.option("plcp").templated<plcp_t, PLCPFromPhi>("plcp");
         m.option("lcp").templated<lcp_t, LCPFromPLCP>("lcp");
         m.option("isa").templated<isa_t, ISAFromSA>("isa");
+        m.option("psv").templated<psv_t, PSVFromSA>("psv");
+        m.option("nsv").templated<nsv_t, NSVFromSA>("nsv");
         m.option("compress").dynamic("delayed");
+        m.option("cache").dynamic("none");
         return m;
     }
 
@@ -145,6 +219,9 @@ public:
         } else {
             m_cm = CompressMode::plain;
         }
+
+        auto& cache_dir = this->env().option("cache").as_string();
+        if(cache_dir != "none") m_cache = DSCache(cache_dir, m_text);
     }
 
     inline TextDS(Env&& env, const View& text, dsflags_t flags, CompressMode cm = CompressMode::select)
@@ -170,6 +247,12 @@ public:
     inline const isa_t& require_isa(CompressMode cm = CompressMode::select) {
         return require_ds(m_isa, "isa", cm);
     }
+    inline const psv_t& require_psv(CompressMode cm = CompressMode::select) {
+        return require_ds(m_psv, "psv", cm);
+    }
+    inline const nsv_t& require_nsv(CompressMode cm = CompressMode::select) {
+        return require_ds(m_nsv, "nsv", cm);
+    }
 
     // inplace methods
 
@@ -198,6 +281,16 @@ public:
 
         return inplace_ds(m_isa, ISA, "isa", cm);
     }
+    inline typename psv_t::data_type inplace_psv(
+        CompressMode cm = CompressMode::select) {
+
+        return inplace_ds(m_psv, PSV, "psv", cm);
+    }
+    inline typename nsv_t::data_type inplace_nsv(
+        CompressMode cm = CompressMode::select) {
+
+        return inplace_ds(m_nsv, NSV, "nsv", cm);
+    }
 
     // release methods
 
@@ -216,6 +309,12 @@ public:
     inline isa_t release_isa() {
         return release_ds(m_isa, ISA, "ISA");
     }
+    inline psv_t release_psv() {
+        return release_ds(m_psv, PSV, "PSV");
+    }
+    inline nsv_t release_nsv() {
+        return release_ds(m_nsv, NSV, "NSV");
+    }
 
 private:
     inline void discard_sa() {
@@ -233,6 +332,12 @@ private:
     inline void discard_isa() {
         discard_ds(m_isa, ISA);
     }
+    inline void discard_psv() {
+        discard_ds(m_psv, PSV);
+    }
+    inline void discard_nsv() {
+        discard_ds(m_nsv, NSV);
+    }
 
     inline void discard_unneeded() {
         // discard unrequested structures
@@ -241,6 +346,8 @@ private:
         if(!(m_ds_requested & PLCP)) discard_plcp();
         if(!(m_ds_requested & LCP)) discard_lcp();
         if(!(m_ds_requested & ISA)) discard_isa();
+        if(!(m_ds_requested & PSV)) discard_psv();
+        if(!(m_ds_requested & NSV)) discard_nsv();
     }
 
 public:
@@ -283,6 +390,20 @@ public:
             if(cm == CompressMode::coherent_delayed) m_isa->compress();
         }
 
+        // Construct and compress PSV
+        if(flags & PSV)  {
+            require_psv(cm);
+            discard_unneeded();
+            if(cm == CompressMode::coherent_delayed) m_psv->compress();
+        }
+
+        // Construct and compress NSV
+        if(flags & NSV)  {
+            require_nsv(cm);
+            discard_unneeded();
+            if(cm == CompressMode::coherent_delayed) m_nsv->compress();
+        }
+
         // Compress data structures that had dependencies
         if(cm == CompressMode::coherent_delayed) {
             if(m_sa) m_sa->compress();
@@ -317,6 +438,8 @@ public:
         if(m_plcp) out << std::setw(w) << "PLCP[i]" << " | ";
         if(m_lcp) out << std::setw(w) << "LCP[i]" << " | ";
         if(m_isa) out << std::setw(w) << "ISA[i]" << " | ";
+        if(m_psv) out << std::setw(w) << "PSV[i]" << " | ";
+        if(m_nsv) out << std::setw(w) << "NSV[i]" << " | ";
         out << std::endl;
 
         //Separator
@@ -327,6 +450,8 @@ public:
         if(m_plcp) out << std::setw(w) << "" << "-|-";
         if(m_lcp) out << std::setw(w) << "" << "-|-";
         if(m_isa) out << std::setw(w) << "" << "-|-";
+        if(m_psv) out << std::setw(w) << "" << "-|-";
+        if(m_nsv) out << std::setw(w) << "" << "-|-";
         out << std::endl;
 
         //Body
@@ -338,6 +463,8 @@ public:
             if(m_plcp) out << std::setw(w) << (*m_plcp)[i] << " | ";
             if(m_lcp) out << std::setw(w) << (*m_lcp)[i] << " | ";
             if(m_isa) out << std::setw(w) << ((*m_isa)[i] + base) << " | ";
+            if(m_psv) out << std::setw(w) << ((*m_psv)[i] + base) << " | ";
+            if(m_nsv) out << std::setw(w) << ((*m_nsv)[i] + base) << " | ";
             out << std::endl;
         }
     }
@@ -13,6 +13,8 @@ namespace ds {
     constexpr dsflags_t LCP  = 0x04;
     constexpr dsflags_t PHI  = 0x08;
     constexpr dsflags_t PLCP = 0x10;
+    constexpr dsflags_t PSV  = 0x20;
+    constexpr dsflags_t NSV  = 0x40;
 
     using io::InputRestrictions;
 
@@ -34,10 +34,10 @@ public:
 
         std::string s(length,0);
         std::default_random_engine engine(seed);
-        std::uniform_int_distribution<char> dist(min, max);
+        std::uniform_int_distribution<size_t> dist(min, max);
 
         for(size_t i = 0; i < length; ++i) {
-            s[i] = dist(engine);
+            s[i] = char(dist(engine));
         }
 
         return s;
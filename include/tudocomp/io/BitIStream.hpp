@@ -1,8 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <climits>
+#include <cstring>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <vector>
 #include <tudocomp/util.hpp>
 
 namespace tdc {
@@ -11,53 +15,157 @@ namespace io {
 /// \brief Wrapper for input streams that provides bitwise reading
 /// functionality.
 ///
-/// The current byte in the underlying input stream is buffered and processed
-/// bitwise using another cursor.
+/// The underlying input stream is read in blocks, and the next bits are held
+/// in a 64-bit accumulator with the next bit at the most significant position.
+///
+/// The low three bits of the last byte in the input tell how many bits of the
+/// byte before them are used. If they are 6 or 7, the last byte contains no
+/// other bits. Therefore, a byte is only moved into the accumulator if at
+/// least two more bytes follow it, or if the end of the input is known.
 class BitIStream {
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    // the maximum amount of bits taken from the accumulator at once
+    static constexpr size_t MAX_BITS = 56;
+
     InputStream m_stream;
 
-    uint8_t m_current, m_next;
+    std::vector<char> m_buffer;
+    size_t m_pos, m_end; // the bytes not yet in the accumulator
+    bool m_stream_end;
+
+    uint64_t m_word; // the next bits, starting at the MSB
+    size_t m_bits;   // the amount of bits in the accumulator
+
+    uint64_t m_read_bytes; // amount of bytes read from the stream
+    uint64_t m_consumed;   // amount of bits read so far
+    uint64_t m_limit;      // the total amount of bits, once known
+
+    inline void read_block() {
+        // keep the bytes that have not been used yet
+        std::copy(m_buffer.begin() + m_pos, m_buffer.begin() + m_end, m_buffer.begin());
+        m_end -= m_pos;
+        m_pos = 0;
+
+        m_stream.read(m_buffer.data() + m_end, BUFFER_SIZE - m_end);
+        const size_t count = m_stream.gcount();
+        m_end += count;
+        m_read_bytes += count;
+
+        if(m_end < BUFFER_SIZE) {
+            // the input is over, determine the amount of padding bits
+            m_stream_end = true;
+
+            size_t padding = 0;
+            if(m_read_bytes > 0) {
+                const uint8_t final_bits = uint8_t(m_buffer[m_end - 1]) & 0x7;
+                padding = (m_read_bytes > 1 && final_bits >= 6)
+                    ? 16 - final_bits : 8 - final_bits;
+            }
+            m_limit = m_consumed + m_bits + 8 * (m_end - m_pos) - padding;
+        }
+    }
 
-    bool m_is_final;
-    uint8_t m_final_bits;
+    // fills the accumulator with at least MAX_BITS bits, unless the input
+    // is over
+    inline void fill() {
+        if(m_bits <= MAX_BITS && m_pos + 10 <= m_end) {
+            // move as many whole bytes as fit at once, at least two more
+            // bytes remain in the buffer
+            const size_t bits = ((64 - m_bits) / 8) * 8;
+
+            uint64_t chunk;
+            std::memcpy(&chunk, m_buffer.data() + m_pos, sizeof(chunk));
+            chunk = __builtin_bswap64(chunk);
+
+            m_word |= (chunk >> (64 - bits)) << (64 - bits - m_bits);
+            m_bits += bits;
+            m_pos += bits / 8;
+            return;
+        }
 
-    uint8_t m_cursor;
+        while(m_bits <= MAX_BITS) {
+            if(!m_stream_end && m_pos + 2 >= m_end) read_block();
+            if(m_pos == m_end) break;
 
-    inline void read_next() {
-        const uint8_t MSB = 7;
+            m_word |= uint64_t(uint8_t(m_buffer[m_pos++])) << (MAX_BITS - m_bits);
+            m_bits += 8;
+        }
+    }
 
-        m_current = m_next;
-        m_cursor = MSB;
+    inline void consume(size_t bits) {
+        m_word = (bits < 64) ? (m_word << bits) : 0;
+        m_bits -= bits;
+        m_consumed += bits;
+    }
 
-        char c;
-        if(m_stream.get(c)) {
-            m_next = c;
+    // the amount of bits in the accumulator that are not beyond the end
+    inline size_t available() const {
+        return size_t(std::min(uint64_t(m_bits), m_limit - m_consumed));
+    }
 
-            if(m_stream.get(c)) {
-                /*DLOG(INFO) << "read_next: ...";*/
+    // reads up to MAX_BITS bits, which are zero beyond the end
+    inline uint64_t read_bits(size_t bits) {
+        if(bits == 0) return 0;
+        if(m_bits < bits) fill();
 
-                // stream still going
-                m_stream.unget();
-            } else {
-                // stream over after next, do some checks
-                m_final_bits = c;
-                m_final_bits &= 0x7;
-                if(m_final_bits >= 6) {
-                    // special case - already final
-                    m_is_final = true;
-                    m_next = 0;
-                    /*DLOG(INFO) << "read_next: EOF*" <<
-                        ", m_final_bits := " << size_t(m_final_bits);*/
-                }
-            }
+        const size_t avail = available();
+        if(bits <= avail) {
+            const uint64_t v = m_word >> (64 - bits);
+            consume(bits);
+            return v;
         } else {
-            m_is_final = true;
-            m_final_bits = m_current & 0x7;
+            const uint64_t v = avail ? (m_word >> (64 - avail)) : 0;
+            consume(avail);
+            return v << (bits - avail);
+        }
+    }
 
-            m_next = 0;
+    inline static size_t leading_zeros(uint64_t word) {
+        return word ? size_t(__builtin_clzll(word)) : 64;
+    }
+
+    // decodes an Elias-gamma code from the accumulator if it holds the
+    // complete code, returns the code length or zero otherwise
+    inline size_t peek_elias_gamma(size_t avail, uint64_t& v) const {
+        const size_t zeros = leading_zeros(m_word);
+        const size_t len = 2 * zeros + 1;
+        if(len > avail) return 0;
+
+        v = zeros ? ((m_word << (zeros + 1)) >> (64 - zeros)) : 0;
+        return len;
+    }
 
-            /*DLOG(INFO) << "read_next: EOF" <<
-                ", m_final_bits := " << size_t(m_final_bits);*/
+    // decodes an Elias-delta code from the accumulator if it holds the
+    // complete code, returns the code length or zero otherwise
+    inline size_t peek_elias_delta(size_t avail, uint64_t& v) const {
+        uint64_t bits;
+        const size_t prefix = peek_elias_gamma(avail, bits);
+        if(prefix == 0 || prefix + bits > avail) return 0;
+
+        v = bits ? ((m_word << prefix) >> (64 - bits)) : 0;
+        return prefix + size_t(bits);
+    }
+
+    // reads count values, decoding as many as possible from each fill of
+    // the accumulator using peek and falling back to read_one otherwise
+    template<typename value_t, typename peek_t, typename read_one_t>
+    inline void read_many(value_t* out, size_t count, peek_t peek, read_one_t read_one) {
+        size_t i = 0;
+        while(i < count) {
+            fill();
+
+            size_t avail = available();
+            const size_t start = i;
+            uint64_t v;
+            for(size_t len; i < count && (len = peek(avail, v)); ++i) {
+                out[i] = value_t(v);
+                consume(len);
+                avail -= len;
+            }
+
+            // the next code is too long or exceeds the input
+            if(i == start) out[i++] = read_one();
         }
     }
 
@@ -65,18 +173,18 @@ public:
     /// \brief Constructs a bitwise input stream.
     ///
     /// \param input The underlying input stream.
-    inline BitIStream(InputStream&& input) : m_stream(std::move(input)) {
-        char c;
-        if(m_stream.get(c)) {
-            m_is_final = false;
-            m_next = c;
-
-            read_next();
-        } else {
-            //empty stream
-            m_is_final = true;
-            m_final_bits = 0;
-        }
+    inline BitIStream(InputStream&& input)
+        : m_stream(std::move(input)),
+          m_buffer(BUFFER_SIZE),
+          m_pos(0),
+          m_end(0),
+          m_stream_end(false),
+          m_word(0),
+          m_bits(0),
+          m_read_bytes(0),
+          m_consumed(0),
+          m_limit(std::numeric_limits<uint64_t>::max()) {
+        fill();
     }
 
     /// \brief Constructs a bitwise input stream.
@@ -88,23 +196,12 @@ public:
     /// \brief Reads the next single bit from the input.
     /// \return 1 if the next bit is set, 0 otherwise.
     inline uint8_t read_bit() {
-        /*DLOG(INFO) <<"read_bit: " <<
-                "m_is_final = " << m_is_final <<
-                ", m_final_bits = " << size_t(m_final_bits) <<
-                ", m_cursor = " << size_t(m_cursor);*/
-
-        if(!eof()) {
-            uint8_t bit = (m_current >> m_cursor) & 1;
-            if(m_cursor) {
-                --m_cursor;
-            } else {
-                read_next();
-            }
+        if(eof()) return 0; //EOF
+        if(m_bits == 0) fill();
 
-            return bit;
-        } else {
-            return 0; //EOF
-        }
+        const uint8_t bit = m_word >> 63;
+        consume(1);
+        return bit;
     }
 
     /// \brief Reads the integer value of the next \c amount bits in MSB first
@@ -116,18 +213,102 @@ public:
     ///         order.
     template<class T>
     inline T read_int(size_t amount = sizeof(T) * CHAR_BIT) {
-        T value = 0;
-        for(size_t i = 0; i < amount; i++) {
-            value <<= 1;
-            value |= read_bit();
+        uint64_t value = 0;
+        while(amount > 0) {
+            const size_t bits = std::min(amount, size_t(MAX_BITS));
+            value = (value << bits) | read_bits(bits);
+            amount -= bits;
         }
-        return value;
+        return T(value);
+    }
+
+    /// \brief Reads a sequence of bytes from the input.
+    ///
+    /// If the input is at a byte boundary, the bytes are copied from the
+    /// buffer in blocks. Otherwise, seven bytes are read at a time. Bytes
+    /// beyond the end of the input are zero.
+    ///
+    /// \param out The array to store the bytes in.
+    /// \param count The amount of bytes to read.
+    inline void read_bytes(uint8_t* out, size_t count) {
+        if(m_bits % 8 == 0) {
+            // drain the accumulator
+            for(; count > 0 && m_bits > 0; --count) *out++ = uint8_t(read_bits(8));
+
+            while(count > 0 && !eof()) {
+                if(!m_stream_end && m_pos + 2 >= m_end) read_block();
+
+                // do not copy the padding at the end of the input
+                const size_t buffered = m_stream_end ? m_end - m_pos : m_end - m_pos - 2;
+                const size_t k = size_t(std::min(uint64_t(std::min(count, buffered)),
+                    (m_limit - m_consumed) / 8));
+                if(k == 0) break;
+
+                std::memcpy(out, m_buffer.data() + m_pos, k);
+                m_pos += k;
+                m_consumed += 8 * k;
+                out += k;
+                count -= k;
+            }
+        } else {
+            for(; count >= 7; count -= 7) {
+                const uint64_t v = read_bits(56);
+                for(size_t j = 0; j < 7; ++j) *out++ = uint8_t(v >> (48 - 8 * j));
+            }
+        }
+
+        for(; count > 0; --count) *out++ = uint8_t(read_bits(8));
+    }
+
+    /// \brief Returns the integer value of the next \c amount bits in MSB
+    ///        first order without reading them.
+    ///
+    /// Bits beyond the end of the input are zero.
+    ///
+    /// \tparam The integer type to return.
+    /// \param amount The amount of bits, at most 56.
+    /// \return The integer value of the next \c amount bits.
+    template<class T>
+    inline T peek_int(size_t amount) {
+        DCHECK_LE(amount, MAX_BITS);
+        if(amount == 0) return T(0);
+        if(m_bits < amount) fill();
+
+        const size_t avail = available();
+        uint64_t v = m_word >> (64 - amount);
+        if(avail < amount) {
+            // clear the padding bits
+            v = avail ? ((v >> (amount - avail)) << (amount - avail)) : 0;
+        }
+        return T(v);
+    }
+
+    /// \brief Skips the next \c amount bits.
+    ///
+    /// \param amount The amount of bits, at most 56.
+    inline void skip(size_t amount) {
+        DCHECK_LE(amount, MAX_BITS);
+        if(m_bits < amount) fill();
+        consume(std::min(amount, available()));
     }
 
     template<typename value_t>
     inline value_t read_unary() {
         value_t v = 0;
-        while(!read_bit()) ++v;
+        while(!eof()) {
+            if(m_bits == 0) fill();
+
+            // count the zeros before the next set bit
+            const size_t avail = available();
+            const size_t zeros = m_word ? size_t(__builtin_clzll(m_word)) : 64;
+            if(zeros < avail) {
+                consume(zeros + 1);
+                return v + value_t(zeros);
+            }
+
+            consume(avail);
+            v += value_t(avail);
+        }
         return v;
     }
 
@@ -150,16 +331,65 @@ public:
 
     template<typename value_t>
     inline value_t read_elias_gamma() {
+        // decode short codes directly from the accumulator
+        uint64_t v;
+        size_t len = peek_elias_gamma(available(), v);
+        if(!len) {
+            fill();
+            len = peek_elias_gamma(available(), v);
+        }
+        if(len) {
+            consume(len);
+            return value_t(v);
+        }
+
         auto bits = read_unary<size_t>();
         return read_int<value_t>(bits);
     }
 
     template<typename value_t>
     inline value_t read_elias_delta() {
+        // decode short codes directly from the accumulator
+        uint64_t v;
+        size_t len = peek_elias_delta(available(), v);
+        if(!len) {
+            fill();
+            len = peek_elias_delta(available(), v);
+        }
+        if(len) {
+            consume(len);
+            return value_t(v);
+        }
+
         auto bits = read_elias_gamma<size_t>();
         return read_int<value_t>(bits);
     }
 
+    /// \brief Reads \c count Elias-gamma codes.
+    ///
+    /// After each refill of the accumulator, all codes it completely holds
+    /// are decoded without further bounds checks.
+    ///
+    /// \param out The array to store the values in.
+    /// \param count The amount of values to read.
+    template<typename value_t>
+    inline void read_elias_gamma(value_t* out, size_t count) {
+        read_many(out, count, [this](size_t avail, uint64_t& v) {
+            return peek_elias_gamma(avail, v);
+        }, [this]() { return read_elias_gamma<value_t>(); });
+    }
+
+    /// \brief Reads \c count Elias-delta codes.
+    ///
+    /// \param out The array to store the values in.
+    /// \param count The amount of values to read.
+    template<typename value_t>
+    inline void read_elias_delta(value_t* out, size_t count) {
+        read_many(out, count, [this](size_t avail, uint64_t& v) {
+            return peek_elias_delta(avail, v);
+        }, [this]() { return read_elias_delta<value_t>(); });
+    }
+
     /// \brief Reads a compressed integer from the input.
     ///
     /// The \e compressed form of an integer \c n is achieved by splitting
@@ -186,11 +416,10 @@ public:
         return T(value);
     }
 
-    /// TODO document
+    /// \brief Tells whether all bits of the input have been read.
     inline bool eof() const {
-        return m_is_final && m_cursor <= (7 - m_final_bits);
+        return m_consumed >= m_limit;
     }
 };
 
 }}
-
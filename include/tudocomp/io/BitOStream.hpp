@@ -1,47 +1,90 @@
 #pragma once
 
+#include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 #include <tudocomp/util.hpp>
 #include <tudocomp/io/Output.hpp>
 
 namespace tdc {
 namespace io {
 
+/// \cond INTERNAL
+/// Converts an integer to \c uint64_t without sign extension, so that the
+/// bits beyond the width of its type are zero.
+template<typename T>
+inline uint64_t bit_representation(T value,
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type* = nullptr) {
+    return uint64_t(typename std::make_unsigned<T>::type(value));
+}
+
+template<typename T>
+inline uint64_t bit_representation(T value,
+    typename std::enable_if<!std::is_integral<T>::value || std::is_same<T, bool>::value>::type* = nullptr) {
+    return uint64_t(value);
+}
+/// \endcond
+
 /// \brief Wrapper for output streams that provides bitwise writing
 /// functionality.
 ///
-/// Bits are written into a buffer byte, which is written to the output when
-/// it is either filled or when a flush is explicitly requested.
+/// Bits are collected in a 64-bit accumulator. Completed bytes are moved into
+/// a block buffer, which is written to the output when it is either filled or
+/// when the stream is destroyed.
 class BitOStream {
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    // the maximum amount of bits passed to the accumulator at once
+    static constexpr size_t MAX_BITS = 32;
+
     OutputStream m_stream;
 
-    bool m_dirty;
-    uint8_t m_next;
-    int m_cursor;
+    std::vector<char> m_buffer;
+    size_t m_fill;
 
-    inline void reset() {
-        const int MSB = 7;
+    uint64_t m_word; // pending bits in the low m_bits bits
+    size_t m_bits;   // always less than 8 between calls
+
+    inline void flush_buffer() {
+        m_stream.write(m_buffer.data(), m_fill);
+        m_fill = 0;
+    }
 
-        m_next = 0;
-        m_cursor = MSB;
-        m_dirty = false;
+    inline void put(uint8_t byte) {
+        m_buffer[m_fill++] = char(byte);
+        if(m_fill == BUFFER_SIZE) flush_buffer();
     }
 
-    inline void write_next() {
-        if (m_dirty) {
-            m_stream.put(char(m_next));
-            reset();
+    // writes the bits of v, which must be less than 2^bits
+    inline void write_bits(uint64_t v, size_t bits) {
+        DCHECK_LE(bits, MAX_BITS);
+
+        m_word = (m_word << bits) | v;
+        m_bits += bits;
+        while(m_bits >= 8) {
+            m_bits -= 8;
+            put(uint8_t(m_word >> m_bits));
         }
     }
 
+    inline static uint64_t low_bits(uint64_t v, size_t bits) {
+        return (bits >= 64) ? v : (v & ((uint64_t(1) << bits) - 1ULL));
+    }
+
 public:
     /// \brief Constructs a bitwise output stream.
     ///
     /// \param output The underlying output stream.
-    inline BitOStream(OutputStream&& output) : m_stream(std::move(output)) {
-        reset();
+    inline BitOStream(OutputStream&& output)
+        : m_stream(std::move(output)),
+          m_buffer(BUFFER_SIZE),
+          m_fill(0),
+          m_word(0),
+          m_bits(0) {
     }
 
     /// \brief Constructs a bitwise output stream.
@@ -51,39 +94,36 @@ public:
     }
 
     ~BitOStream() {
-        char set = 7 - m_cursor;
-        if(m_cursor >= 2) {
-            m_next |= set;
+        // the low three bits of the last byte store the amount of bits
+        // used in the byte before them
+        const uint8_t set = m_bits;
+        const uint8_t current = uint8_t(m_word << (8 - m_bits));
+        if(m_bits <= 5) {
+            put(current | set);
         } else {
-            write_next();
-            m_next = set;
+            put(current);
+            put(set);
         }
-
-        m_dirty = true;
-        write_next();
+        flush_buffer();
     }
 
-    /// \brief Returns the output position indicator of the underlying stream,
-    ///        which should equal the amount of bytes written to it.
+    /// \brief Returns the amount of complete bytes written so far.
     ///
-    /// Note that this value does not include bits that have not yet been
-    /// flushed.
+    /// This includes the bytes that are still buffered, but not bits that
+    /// do not yet form a complete byte.
     ///
-    /// \return the output position indicator of the underlying stream
+    /// \return the amount of bytes written
     inline auto tellp() -> decltype(m_stream.tellp()) {
-        return m_stream.tellp();
+        return m_stream.tellp() + std::streamoff(m_fill);
     }
 
     /// \brief Writes a single bit to the output.
     /// \param set The bit value (0 or 1).
     inline void write_bit(bool set) {
-        if (set) {
-            m_next |= (1 << m_cursor);
-        }
-
-        m_dirty = true;
-        if (--m_cursor < 0) {
-            write_next();
+        m_word = (m_word << 1) | uint64_t(set);
+        if(++m_bits == 8) {
+            m_bits = 0;
+            put(uint8_t(m_word));
         }
     }
 
@@ -96,18 +136,50 @@ public:
     ///             this equals the bit width of type \c T.
     template<class T>
     inline void write_int(T value, size_t bits = sizeof(T) * CHAR_BIT) {
-        for (int i = bits - 1; i >= 0; i--) {
-            write_bit((value & T(T(1) << i)) != T(0));
+        const uint64_t v = bit_representation(value);
+        for(; bits > 64; ) {
+            // the bits beyond the integer are zero
+            const size_t k = std::min(bits - 64, size_t(MAX_BITS));
+            write_bits(0, k);
+            bits -= k;
+        }
+        if(bits > MAX_BITS) {
+            write_bits(low_bits(v >> MAX_BITS, bits - MAX_BITS), bits - MAX_BITS);
+            bits = MAX_BITS;
+        }
+        write_bits(low_bits(v, bits), bits);
+    }
+
+    /// \brief Writes a sequence of bytes to the output.
+    ///
+    /// If the output is at a byte boundary, the bytes are copied in blocks.
+    ///
+    /// \param bytes The bytes to write.
+    /// \param count The amount of bytes.
+    inline void write_bytes(const uint8_t* bytes, size_t count) {
+        if(m_bits == 0) {
+            while(count > 0) {
+                const size_t k = std::min(count, BUFFER_SIZE - m_fill);
+                std::memcpy(m_buffer.data() + m_fill, bytes, k);
+                m_fill += k;
+                bytes += k;
+                count -= k;
+                if(m_fill == BUFFER_SIZE) flush_buffer();
+            }
+        } else {
+            for(size_t i = 0; i < count; ++i) {
+                m_word = (m_word << 8) | uint64_t(bytes[i]);
+                put(uint8_t(m_word >> m_bits));
+            }
         }
     }
 
     template<typename value_t>
     inline void write_unary(value_t v) {
-        while(v--) {
-            write_bit(0);
+        for(; v >= value_t(MAX_BITS); v -= value_t(MAX_BITS)) {
+            write_bits(0, MAX_BITS);
         }
-
-        write_bit(1);
+        write_bits(1, size_t(v) + 1);
     }
 
     template<typename value_t>
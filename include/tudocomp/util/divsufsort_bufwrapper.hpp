@@ -40,22 +40,22 @@ private:
     DynamicIntVector& m_buffer;
     saidx_t m_index;
 
-    // upper value bounds for bit width
-    const uint64_t m_upper, m_upper_signed;
+    // amount of unused high bits in a 64-bit word
+    const uint64_t m_shift;
 
     inline saidx_t to_signed(uint64_t v) {
-        return (v >= m_upper_signed) ? -(m_upper - v) : v;
+        // sign extension of the stored two's complement value
+        return saidx_t(int64_t(v << m_shift) >> m_shift);
     }
 
     inline uint64_t to_unsigned(saidx_t v) {
-        return (v < 0) ? (m_upper + v) : v;
+        return (uint64_t(int64_t(v)) << m_shift) >> m_shift;
     }
 
 public:
     inline Accessor(DynamicIntVector& buffer, saidx_t i)
         : m_buffer(buffer), m_index(i),
-          m_upper(1ULL << buffer.width()),
-          m_upper_signed(m_upper >> 1ULL)
+          m_shift(64ULL - buffer.width())
     {
     }
 
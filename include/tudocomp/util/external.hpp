@@ -0,0 +1,254 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <tudocomp/util.hpp>
+
+namespace tdc {
+namespace external {
+
+/// \brief Returns a unique path for a temporary file in a scratch directory.
+///
+/// \param dir The scratch directory, which must exist.
+/// \param name A descriptive name that becomes part of the file name.
+inline std::string scratch_path(const std::string& dir, const std::string& name) {
+    static std::atomic<size_t> counter(0);
+    return dir + "/tdc-" + std::to_string(getpid()) + "-"
+        + std::to_string(counter++) + "." + name;
+}
+
+/// \brief Sequentially writes trivially copyable items to a file.
+///
+/// Items are collected in a buffer of fixed size, which is written to the
+/// file whenever it is full.
+template<typename T>
+class BufferedWriter {
+private:
+    std::ofstream m_out;
+    std::vector<T> m_buffer;
+    size_t m_capacity;
+
+public:
+    /// Creates (or truncates) the file at the given path.
+    ///
+    /// \param path The file path.
+    /// \param buffer_bytes The size of the buffer in bytes.
+    inline BufferedWriter(const std::string& path, size_t buffer_bytes)
+        : m_out(path, std::ios::out | std::ios::binary | std::ios::trunc),
+          m_capacity(std::max(size_t(1), buffer_bytes / sizeof(T))) {
+
+        CHECK(m_out) << "could not create " << path;
+        m_buffer.reserve(m_capacity);
+    }
+
+    inline ~BufferedWriter() {
+        flush();
+    }
+
+    /// Appends an item.
+    inline void write(const T& x) {
+        m_buffer.push_back(x);
+        if(m_buffer.size() == m_capacity) flush();
+    }
+
+    /// Writes all buffered items to the file.
+    inline void flush() {
+        if(!m_buffer.empty()) {
+            m_out.write((const char*)m_buffer.data(), m_buffer.size() * sizeof(T));
+            CHECK(m_out) << "could not write to scratch file";
+            m_buffer.clear();
+        }
+        m_out.flush();
+    }
+};
+
+/// \brief Sequentially reads trivially copyable items from a file.
+template<typename T>
+class BufferedReader {
+private:
+    std::ifstream m_in;
+    std::vector<T> m_buffer;
+    size_t m_capacity;
+    size_t m_pos;
+
+    inline void fill() {
+        m_buffer.resize(m_capacity);
+        m_in.read((char*)m_buffer.data(), m_capacity * sizeof(T));
+        m_buffer.resize(m_in.gcount() / sizeof(T));
+        m_pos = 0;
+    }
+
+public:
+    /// Opens the file at the given path.
+    ///
+    /// \param path The file path.
+    /// \param buffer_bytes The size of the buffer in bytes.
+    /// \param offset The index of the first item to read.
+    inline BufferedReader(const std::string& path, size_t buffer_bytes, size_t offset = 0)
+        : m_in(path, std::ios::in | std::ios::binary),
+          m_capacity(std::max(size_t(1), buffer_bytes / sizeof(T))),
+          m_pos(0) {
+
+        CHECK(m_in) << "could not open " << path;
+        m_in.seekg(offset * sizeof(T));
+    }
+
+    /// Reads the next item.
+    ///
+    /// \return \e false if the end of the file has been reached.
+    inline bool next(T& x) {
+        if(m_pos == m_buffer.size()) {
+            fill();
+            if(m_buffer.empty()) return false;
+        }
+        x = m_buffer[m_pos++];
+        return true;
+    }
+};
+
+/// \brief Sorts a sequence of trivially copyable items that may exceed the
+///        available memory.
+///
+/// Items are collected in a buffer that is bounded by a memory budget.
+/// Whenever the buffer is full, it is sorted and written to the scratch
+/// directory as a run. The sorted sequence is then produced by a multiway
+/// merge of all runs, or directly from memory if no run had to be written.
+///
+/// \tparam T The item type.
+/// \tparam less_t The comparison function.
+template<typename T, typename less_t = std::less<T>>
+class ExternalSorter {
+public:
+    /// \brief The item type.
+    using value_type = T;
+
+private:
+    std::string m_dir;
+    size_t m_budget;
+    less_t m_less;
+
+    std::vector<T> m_buffer;
+    size_t m_capacity;
+
+    std::vector<std::string> m_runs;
+    size_t m_size;
+
+    inline void write_run() {
+        std::sort(m_buffer.begin(), m_buffer.end(), m_less);
+
+        m_runs.emplace_back(scratch_path(m_dir, "run"));
+        std::ofstream out(m_runs.back(), std::ios::out | std::ios::binary);
+        out.write((const char*)m_buffer.data(), m_buffer.size() * sizeof(T));
+        CHECK(out) << "could not write " << m_runs.back();
+
+        m_buffer.clear();
+    }
+
+    inline void remove_runs() {
+        for(auto& run : m_runs) std::remove(run.c_str());
+        m_runs.clear();
+    }
+
+public:
+    /// Creates an empty sorter.
+    ///
+    /// \param dir The scratch directory for the runs, which must exist.
+    /// \param budget The amount of memory to use in bytes.
+    /// \param less The comparison function.
+    inline ExternalSorter(const std::string& dir, size_t budget, less_t less = less_t())
+        : m_dir(dir),
+          m_budget(budget),
+          m_less(less),
+          m_capacity(std::max(size_t(1), budget / sizeof(T))),
+          m_size(0) {
+    }
+
+    inline ~ExternalSorter() {
+        remove_runs();
+    }
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    /// Adds an item.
+    inline void push(const T& x) {
+        if(m_buffer.size() == m_buffer.capacity()) {
+            // grow without exceeding the budget
+            m_buffer.reserve(std::min(m_capacity,
+                std::max(size_t(1024), 2 * m_buffer.capacity())));
+        }
+
+        m_buffer.push_back(x);
+        ++m_size;
+        if(m_buffer.size() == m_capacity) write_run();
+    }
+
+    /// Returns the amount of items added.
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// Returns the amount of runs that have been written to disk so far.
+    inline size_t runs() const {
+        return m_runs.size();
+    }
+
+    /// Passes all items to a function in sorted order.
+    ///
+    /// This consumes the sorter, i.e., it will be empty afterwards.
+    ///
+    /// \param f The function, called as \c f(item) for every item.
+    template<typename F>
+    inline void sorted(F f) {
+        if(m_runs.empty()) {
+            // everything fits into memory
+            std::sort(m_buffer.begin(), m_buffer.end(), m_less);
+            for(auto& x : m_buffer) f(x);
+        } else {
+            if(!m_buffer.empty()) write_run();
+            std::vector<T>().swap(m_buffer); // free buffer for the merge
+
+            // merge runs, sharing the budget among their buffers
+            const size_t k = m_runs.size();
+            std::vector<BufferedReader<T>> readers;
+            readers.reserve(k);
+            for(auto& run : m_runs) readers.emplace_back(run, m_budget / k);
+
+            using entry_t = std::pair<T, size_t>;
+            auto greater = [&](const entry_t& a, const entry_t& b) {
+                return m_less(b.first, a.first);
+            };
+            std::priority_queue<entry_t, std::vector<entry_t>, decltype(greater)> heap(greater);
+
+            T x;
+            for(size_t r = 0; r < k; ++r) {
+                if(readers[r].next(x)) heap.emplace(x, r);
+            }
+
+            while(!heap.empty()) {
+                const entry_t top = heap.top();
+                heap.pop();
+
+                f(top.first);
+                if(readers[top.second].next(x)) heap.emplace(x, top.second);
+            }
+
+            readers.clear();
+            remove_runs();
+        }
+
+        std::vector<T>().swap(m_buffer);
+        m_size = 0;
+    }
+};
+
+}} //ns
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <tudocomp/util.hpp>
+
+namespace tdc {
+namespace parallel {
+
+/// \brief Resolves the value of a \c threads option.
+///
+/// \param requested The requested amount of threads, or zero to use all
+///                  hardware threads.
+/// \return The amount of threads to use (guaranteed to be greater than zero).
+inline size_t num_threads(size_t requested) {
+    if(requested > 0) return requested;
+
+    const size_t hw = std::thread::hardware_concurrency();
+    return (hw > 0) ? hw : 1;
+}
+
+/// \brief Runs a function on the given amount of threads and waits for all
+///        of them to finish.
+///
+/// The calling thread takes part as the thread with id zero. Memory should
+/// be allocated before calling this, because \ref StatPhase does not track
+/// allocations made in the other threads.
+///
+/// \param threads The amount of threads.
+/// \param f The function, called as \c f(tid) with \c tid in
+///          <tt>[0, threads)</tt>.
+template<typename F>
+inline void run(size_t threads, F f) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads > 0 ? threads - 1 : 0);
+
+    for(size_t tid = 1; tid < threads; ++tid) {
+        workers.emplace_back([&f, tid]{ f(tid); });
+    }
+    f(size_t(0));
+
+    for(auto& w : workers) w.join();
+}
+
+/// \brief Splits the range <tt>[0, n)</tt> into one contiguous block per
+///        thread and processes the blocks in parallel.
+///
+/// Block boundaries are multiples of \c align. Using an alignment of 64
+/// allows threads to write into disjoint blocks of a bit-packed
+/// \ref IntVector, because the blocks never share a 64-bit word.
+///
+/// \param threads The amount of threads.
+/// \param n The size of the range.
+/// \param f The function, called as \c f(begin, end) for each non-empty block.
+/// \param align The block alignment.
+template<typename F>
+inline void for_blocks(size_t threads, size_t n, F f, size_t align = 1) {
+    const size_t block = idiv_ceil(idiv_ceil(n, align), threads) * align;
+
+    run(threads, [&](size_t tid){
+        const size_t begin = std::min(n, tid * block);
+        const size_t end = std::min(n, begin + block);
+        if(begin < end) f(begin, end);
+    });
+}
+
+/// \brief Sorts a range in parallel.
+///
+/// The range is split into one block per thread, the blocks are sorted
+/// using \c std::sort and then merged pairwise in parallel rounds using a
+/// buffer of the size of the range.
+///
+/// \param begin Pointer to the first element.
+/// \param end Pointer behind the last element.
+/// \param comp The comparison function.
+/// \param threads The amount of threads.
+template<typename T, typename Compare>
+inline void sort(T* begin, T* end, Compare comp, size_t threads) {
+    const size_t n = end - begin;
+    threads = std::max(size_t(1), std::min(threads, n / 1024));
+
+    if(threads == 1) {
+        std::sort(begin, end, comp);
+        return;
+    }
+
+    // block boundaries
+    std::vector<size_t> bound(threads + 1);
+    for(size_t i = 0; i <= threads; ++i) bound[i] = (n * i) / threads;
+
+    run(threads, [&](size_t tid){
+        std::sort(begin + bound[tid], begin + bound[tid+1], comp);
+    });
+
+    // merge rounds
+    std::vector<T> buffer(n);
+    T* src = begin;
+    T* dst = buffer.data();
+
+    for(size_t w = 1; w < threads; w *= 2) {
+        run(idiv_ceil(threads, 2 * w), [&](size_t tid){
+            const size_t l = 2 * w * tid;
+            const size_t m = std::min(l + w, threads);
+            const size_t r = std::min(l + 2 * w, threads);
+
+            std::merge(src + bound[l], src + bound[m],
+                       src + bound[m], src + bound[r],
+                       dst + bound[l], comp);
+        });
+        std::swap(src, dst);
+    }
+
+    if(src != begin) {
+        for_blocks(threads, n, [&](size_t b, size_t e){
+            std::copy(src + b, src + e, begin + b);
+        });
+    }
+}
+
+}} //ns
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstring>
+#include <tudocomp/util.hpp>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace tdc {
+
+/// \cond INTERNAL
+namespace streamvbyte {
+
+/// \brief Lookup tables for decoding a group of four integers, indexed by
+///        the group's control byte.
+struct Tables {
+    /// Maps the data bytes of a group to the bytes of four 32-bit integers.
+    alignas(16) uint8_t shuffle[256][16];
+
+    /// The amount of data bytes of a group.
+    uint8_t length[256];
+
+    inline Tables() {
+        for(size_t c = 0; c < 256; ++c) {
+            size_t offset = 0;
+            for(size_t i = 0; i < 4; ++i) {
+                const size_t len = ((c >> (2 * i)) & 3) + 1;
+                for(size_t j = 0; j < 4; ++j) {
+                    shuffle[c][4 * i + j] = (j < len) ? uint8_t(offset + j) : 0x80;
+                }
+                offset += len;
+            }
+            length[c] = uint8_t(offset);
+        }
+    }
+};
+
+inline const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+inline size_t byte_length(uint32_t v) {
+    return (v < (1U << 8)) ? 1 : (v < (1U << 16)) ? 2 : (v < (1U << 24)) ? 3 : 4;
+}
+
+}
+/// \endcond
+
+/**
+ * Returns the amount of control bytes used to encode \c n integers in the
+ * Stream VByte format.
+ */
+inline size_t stream_vbyte_control_bytes(size_t n) {
+    return (n + 3) / 4;
+}
+
+/**
+ * Returns the maximum amount of bytes needed to encode \c n integers in the
+ * Stream VByte format.
+ */
+inline size_t stream_vbyte_max_bytes(size_t n) {
+    return stream_vbyte_control_bytes(n) + 4 * n;
+}
+
+/**
+ * Encodes integers in the Stream VByte format.
+ *
+ * Each integer is stored using one to four bytes in little endian order.
+ * The byte lengths of four consecutive integers are stored as 2-bit codes in
+ * one control byte. All control bytes precede the data bytes, so that groups
+ * of four integers can be decoded using a single shuffle operation.
+ *
+ * \param in the integers to encode.
+ * \param n the amount of integers.
+ * \param out the output buffer, which must hold at least
+ *            \ref stream_vbyte_max_bytes(n) bytes.
+ * \return the amount of bytes written.
+ */
+inline size_t encode_stream_vbyte(const uint32_t* in, size_t n, uint8_t* out) {
+    uint8_t* control = out;
+    uint8_t* data = out + stream_vbyte_control_bytes(n);
+
+    std::memset(control, 0, stream_vbyte_control_bytes(n));
+    for(size_t i = 0; i < n; ++i) {
+        const uint32_t v = in[i];
+        const size_t len = streamvbyte::byte_length(v);
+        control[i / 4] |= uint8_t(len - 1) << (2 * (i % 4));
+
+        for(size_t j = 0; j < len; ++j) *data++ = uint8_t(v >> (8 * j));
+    }
+    return data - out;
+}
+
+/**
+ * Decodes integers in the Stream VByte format.
+ *
+ * If SSSE3 is available, groups of four integers are decoded using byte
+ * shuffles.
+ *
+ * \param in the encoded integers.
+ * \param size the amount of bytes available in \c in.
+ * \param out the output buffer for \c n integers.
+ * \param n the amount of integers to decode.
+ * \return the amount of bytes read.
+ */
+inline size_t decode_stream_vbyte(const uint8_t* in, size_t size, uint32_t* out, size_t n) {
+    const uint8_t* control = in;
+    const uint8_t* data = in + stream_vbyte_control_bytes(n);
+    const uint8_t* end = in + size;
+    DCHECK_LE(data, end);
+
+    const auto& t = streamvbyte::tables();
+    size_t i = 0;
+
+#ifdef __SSSE3__
+    // full groups, as long as 16 bytes can be loaded
+    for(; i + 4 <= n && data + 16 <= end; i += 4) {
+        const uint8_t c = control[i / 4];
+        const __m128i bytes = _mm_loadu_si128((const __m128i*)data);
+        const __m128i shuffle = _mm_load_si128((const __m128i*)t.shuffle[c]);
+        _mm_storeu_si128((__m128i*)(out + i), _mm_shuffle_epi8(bytes, shuffle));
+        data += t.length[c];
+    }
+#endif
+
+    for(; i < n; ++i) {
+        const size_t len = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        DCHECK_LE(data + len, end);
+
+        uint32_t v = 0;
+        for(size_t j = 0; j < len; ++j) v |= uint32_t(*data++) << (8 * j);
+        out[i] = v;
+    }
+    return data - in;
+}
+
+}//ns
+
@@ -36,17 +36,27 @@ public:
     keyval* first_stat;
 
     PhaseData* first_child;
+    PhaseData* last_child;
     PhaseData* next_sibling;
 
     inline PhaseData()
         : first_stat(nullptr),
           first_child(nullptr),
+          last_child(nullptr),
           next_sibling(nullptr) {
     }
 
     inline ~PhaseData() {
         if(first_stat) delete first_stat;
-        if(first_child) delete first_child;
+
+        // delete children iteratively, phases may have many of them
+        while(first_child) {
+            PhaseData* next = first_child->next_sibling;
+            first_child->next_sibling = nullptr;
+            delete first_child;
+            first_child = next;
+        }
+
         if(next_sibling) delete next_sibling;
     }
 
@@ -18,9 +18,13 @@ namespace tdc {
 /// Phases are used to track runtime and memory allocations over the course
 /// of the application. The measured data can be printed as a JSON string for
 /// use in the tudocomp charter for visualization or third party applications.
+///
+/// Phases are tracked per thread. Phases started in another thread do not
+/// become sub phases of the calling thread's current phase, and allocations
+/// made in other threads are not tracked by it.
 class StatPhase {
 private:
-    static StatPhase* s_current;
+    static thread_local StatPhase* s_current;
 
     inline static unsigned long current_time_millis() {
         timespec t;
@@ -35,15 +39,12 @@ private:
     bool m_track_memory;
 
     inline void append_child(PhaseData* data) {
-        if(m_data->first_child) {
-            PhaseData* last = m_data->first_child;
-            while(last->next_sibling) {
-                last = last->next_sibling;
-            }
-            last->next_sibling = data;
+        if(m_data->last_child) {
+            m_data->last_child->next_sibling = data;
         } else {
             m_data->first_child = data;
         }
+        m_data->last_child = data;
     }
 
     inline void track_alloc_internal(size_t bytes) {
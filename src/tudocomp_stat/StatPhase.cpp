@@ -5,7 +5,7 @@
 
 using tdc::StatPhase;
 
-StatPhase* StatPhase::s_current = nullptr;
+thread_local StatPhase* StatPhase::s_current = nullptr;
 
 void malloc_callback::on_alloc(size_t bytes) {
     StatPhase::track_alloc(bytes);
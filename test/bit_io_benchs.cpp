@@ -0,0 +1,98 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+
+#include <benchpress/benchpress.hpp>
+
+#include <tudocomp/io.hpp>
+
+using namespace tdc;
+using namespace benchpress;
+
+const size_t N_VALUES = 1000000;
+
+/// Returns pairs of random values and their bit widths.
+static const std::vector<std::pair<uint64_t, size_t>>& values() {
+    static std::vector<std::pair<uint64_t, size_t>> v = []{
+        std::mt19937_64 rnd(42);
+        std::vector<std::pair<uint64_t, size_t>> r;
+        for(size_t i = 0; i < N_VALUES; ++i) {
+            const size_t bits = 1 + rnd() % 32;
+            r.emplace_back(rnd() & ((1ULL << bits) - 1), bits);
+        }
+        return r;
+    }();
+    return v;
+}
+
+template<class F>
+inline std::string write_values(F f) {
+    std::vector<uint8_t> buffer;
+    {
+        Output output(buffer);
+        BitOStream out(output);
+        for(auto& x : values()) f(out, x.first, x.second);
+    }
+    return std::string(buffer.begin(), buffer.end());
+}
+
+struct WriteBit {
+    inline static void write(BitOStream& out, uint64_t v, size_t) {
+        out.write_bit(v & 1);
+    }
+    inline static uint64_t read(BitIStream& in, size_t) {
+        return in.read_bit();
+    }
+};
+
+struct WriteInt {
+    inline static void write(BitOStream& out, uint64_t v, size_t bits) {
+        out.write_int(v, bits);
+    }
+    inline static uint64_t read(BitIStream& in, size_t bits) {
+        return in.read_int<uint64_t>(bits);
+    }
+};
+
+struct WriteGamma {
+    inline static void write(BitOStream& out, uint64_t v, size_t) {
+        out.write_elias_gamma(v + 1);
+    }
+    inline static uint64_t read(BitIStream& in, size_t) {
+        return in.read_elias_gamma<uint64_t>();
+    }
+};
+
+template<class Op>
+inline void bench_write(benchpress::context* ctx) {
+    values();
+    ctx->reset_timer();
+
+    for (size_t i = 0; i < ctx->num_iterations(); ++i) {
+        auto s = write_values(Op::write);
+        escape(&s);
+    }
+}
+
+template<class Op>
+inline void bench_read(benchpress::context* ctx) {
+    const std::string data = write_values(Op::write);
+    ctx->reset_timer();
+
+    for (size_t i = 0; i < ctx->num_iterations(); ++i) {
+        Input input(data);
+        BitIStream in(input);
+
+        uint64_t sum = 0;
+        for(auto& x : values()) sum += Op::read(in, x.second);
+        escape(&sum);
+    }
+}
+
+BENCHMARK("write::bit", bench_write<WriteBit>)
+BENCHMARK("write::int", bench_write<WriteInt>)
+BENCHMARK("write::elias_gamma", bench_write<WriteGamma>)
+BENCHMARK("read::bit", bench_read<WriteBit>)
+BENCHMARK("read::int", bench_read<WriteInt>)
+BENCHMARK("read::elias_gamma", bench_read<WriteGamma>)
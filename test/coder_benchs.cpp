@@ -0,0 +1,104 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+
+#include <benchpress/benchpress.hpp>
+
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/io.hpp>
+#include <tudocomp/Literal.hpp>
+#include <tudocomp/coders/EliasGammaCoder.hpp>
+#include <tudocomp/coders/EliasDeltaCoder.hpp>
+#include <tudocomp/coders/StreamVByteCoder.hpp>
+
+using namespace tdc;
+using namespace benchpress;
+
+const size_t N_VALUES = 1000000;
+
+/// Returns random values with geometrically distributed bit widths.
+static const std::vector<uint64_t>& values() {
+    static std::vector<uint64_t> v = []{
+        std::mt19937_64 rnd(42);
+        std::geometric_distribution<size_t> width(0.2);
+        std::vector<uint64_t> r;
+        for(size_t i = 0; i < N_VALUES; ++i) {
+            const size_t bits = 1 + std::min(width(rnd), size_t(31));
+            r.push_back((rnd() >> (64 - bits)) | (1ULL << (bits - 1)));
+        }
+        return r;
+    }();
+    return v;
+}
+
+template<class coder_t>
+inline std::string encode_values() {
+    std::vector<uint8_t> buffer;
+    {
+        Output output(buffer);
+        typename coder_t::Encoder coder(create_env(coder_t::meta()), output, NoLiterals());
+        for(auto v : values()) coder.encode(v, len_r);
+    }
+    return std::string(buffer.begin(), buffer.end());
+}
+
+/// Decodes the unary prefix bit by bit, as a baseline.
+struct Bitwise {
+    inline static uint64_t read_gamma(BitIStream& in) {
+        size_t bits = 0;
+        while(!in.read_bit()) ++bits;
+        return in.read_int<uint64_t>(bits);
+    }
+
+    template<class decoder_t>
+    inline static void decode(decoder_t&, BitIStream& in, uint64_t* out, size_t n, EliasGammaCoder*) {
+        for(size_t i = 0; i < n; ++i) out[i] = read_gamma(in);
+    }
+
+    template<class decoder_t>
+    inline static void decode(decoder_t&, BitIStream& in, uint64_t* out, size_t n, EliasDeltaCoder*) {
+        for(size_t i = 0; i < n; ++i) out[i] = in.read_int<uint64_t>(read_gamma(in));
+    }
+};
+
+/// Decodes one value after the other.
+struct Scalar {
+    template<class decoder_t, class coder_t>
+    inline static void decode(decoder_t& decoder, BitIStream&, uint64_t* out, size_t n, coder_t*) {
+        for(size_t i = 0; i < n; ++i) out[i] = decoder.template decode<uint64_t>(len_r);
+    }
+};
+
+/// Decodes all values at once.
+struct Bulk {
+    template<class decoder_t, class coder_t>
+    inline static void decode(decoder_t& decoder, BitIStream&, uint64_t* out, size_t n, coder_t*) {
+        decoder.decode_many(len_r, out, n);
+    }
+};
+
+template<class coder_t, class Op>
+inline void bench_decode(benchpress::context* ctx) {
+    const std::string data = encode_values<coder_t>();
+    std::vector<uint64_t> out(values().size());
+    ctx->reset_timer();
+
+    for (size_t i = 0; i < ctx->num_iterations(); ++i) {
+        Input input(data);
+        auto in = std::make_shared<BitIStream>(input);
+        typename coder_t::Decoder decoder(create_env(coder_t::meta()), in);
+
+        Op::decode(decoder, *in, out.data(), out.size(), (coder_t*)nullptr);
+        escape(out.data());
+    }
+}
+
+BENCHMARK("gamma::bitwise", (bench_decode<EliasGammaCoder, Bitwise>))
+BENCHMARK("gamma::decode", (bench_decode<EliasGammaCoder, Scalar>))
+BENCHMARK("gamma::decode_many", (bench_decode<EliasGammaCoder, Bulk>))
+BENCHMARK("delta::bitwise", (bench_decode<EliasDeltaCoder, Bitwise>))
+BENCHMARK("delta::decode", (bench_decode<EliasDeltaCoder, Scalar>))
+BENCHMARK("delta::decode_many", (bench_decode<EliasDeltaCoder, Bulk>))
+BENCHMARK("stream_vbyte::decode", (bench_decode<StreamVByteCoder, Scalar>))
@@ -8,6 +8,7 @@
 
 #include <tudocomp/generators/FibonacciGenerator.hpp>
 #include <tudocomp/generators/ThueMorseGenerator.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
 
 #include <tudocomp/coders/ASCIICoder.hpp>
 #include <tudocomp/coders/EliasDeltaCoder.hpp>
@@ -16,6 +17,11 @@
 #include <tudocomp/coders/SLECoder.hpp>
 #include <tudocomp/coders/ArithmeticCoder.hpp>
 #include <tudocomp/coders/TernaryCoder.hpp>
+#include <tudocomp/coders/RANSCoder.hpp>
+#include <tudocomp/coders/AdaptiveArithmeticCoder.hpp>
+#include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/coders/SplitCoder.hpp>
+#include <tudocomp/coders/StreamVByteCoder.hpp>
 
 using namespace tdc;
 
@@ -197,6 +203,34 @@ TEST(coder, sle_int) { test_int<SLECoder>(); }
 TEST(coder, sle_str) { test_str<SLECoder>(); }
 TEST(coder, sle_mixed) { test_mixed<SLECoder>(); }
 
+TEST(coder, sle_literals) {
+    const std::string word = FibonacciGenerator::generate(24);
+    const View text(word);
+
+    // encode literal by literal and as a whole, interrupted by a bit
+    auto encode = [&](bool bulk) {
+        std::stringstream ss;
+        {
+            Output out(ss);
+            SLECoder::Encoder coder(create_env(SLECoder::meta()), out, ViewLiterals(text));
+
+            const size_t half = text.size() / 2;
+            if(bulk) {
+                coder.encode_literals(text.substr(0, half));
+                coder.encode(true, bit_r);
+                coder.encode_literals(text.substr(half));
+            } else {
+                for(size_t i = 0; i < half; i++) coder.encode(text[i], literal_r);
+                coder.encode(true, bit_r);
+                for(size_t i = half; i < text.size(); i++) coder.encode(text[i], literal_r);
+            }
+        }
+        return ss.str();
+    };
+
+    ASSERT_EQ(encode(false), encode(true));
+}
+
 TEST(coder, delta_mt) { test_mt<EliasDeltaCoder>(); }
 TEST(coder, delta_bits) { test_bits<EliasDeltaCoder>(); }
 TEST(coder, delta_int) { test_int<EliasDeltaCoder>(); }
@@ -209,6 +243,35 @@ TEST(coder, gamma_int) { test_int<EliasDeltaCoder>(); }
 TEST(coder, gamma_str) { test_str<EliasDeltaCoder>(); }
 TEST(coder, gamma_mixed) { test_mixed<EliasDeltaCoder>(); }
 
+template<typename coder_t>
+void test_decode_many() {
+    // Encode Fibonacci numbers
+    std::vector<uint64_t> values;
+    for(uint64_t a = 0, b = 1, t; b >= a; t = b, b += a, a = t) values.push_back(b);
+
+    std::stringstream ss;
+    {
+        Output out(ss);
+        typename coder_t::Encoder coder(create_env(coder_t::meta()), out, NoLiterals());
+        for(auto v : values) coder.encode(v, size_r);
+    }
+
+    // Decode them at once
+    std::string result = ss.str();
+    {
+        Input in(result);
+        typename coder_t::Decoder decoder(create_env(coder_t::meta()), in);
+
+        std::vector<uint64_t> decoded(values.size());
+        decoder.decode_many(size_r, decoded.data(), decoded.size());
+        ASSERT_EQ(values, decoded);
+        ASSERT_TRUE(decoder.eof());
+    }
+}
+
+TEST(coder, gamma_decode_many) { test_decode_many<EliasGammaCoder>(); }
+TEST(coder, delta_decode_many) { test_decode_many<EliasDeltaCoder>(); }
+
 TEST(coder, huff_mt) { test_mt<HuffmanCoder>(); }
 TEST(coder, huff_bits) { test_bits<HuffmanCoder>(); }
 TEST(coder, huff_int) { test_int<HuffmanCoder>(); }
@@ -226,3 +289,74 @@ TEST(coder, ternary_bits) { test_bits<TernaryCoder>(); }
 TEST(coder, ternary_int) { test_int<TernaryCoder>(); }
 TEST(coder, ternary_str) { test_str<TernaryCoder>(); }
 TEST(coder, ternary_mixed) { test_mixed<TernaryCoder>(); }
+
+TEST(coder, adaptive_mt) { test_mt<AdaptiveArithmeticCoder>(); }
+TEST(coder, adaptive_bits) { test_bits<AdaptiveArithmeticCoder>(); }
+TEST(coder, adaptive_int) { test_int<AdaptiveArithmeticCoder>(); }
+TEST(coder, adaptive_str) { test_str<AdaptiveArithmeticCoder>(); }
+TEST(coder, adaptive_mixed) { test_mixed<AdaptiveArithmeticCoder>(); }
+
+using split_coder_t = SplitCoder<
+    HuffmanCoder, AdaptiveArithmeticCoder, BitCoder, EliasGammaCoder>;
+
+TEST(coder, split_mt) { test_mt<split_coder_t>(); }
+TEST(coder, split_bits) { test_bits<split_coder_t>(); }
+TEST(coder, split_int) { test_int<split_coder_t>(); }
+TEST(coder, split_str) { test_str<split_coder_t>(); }
+TEST(coder, split_mixed) { test_mixed<split_coder_t>(); }
+
+TEST(coder, stream_vbyte_mt) { test_mt<StreamVByteCoder>(); }
+TEST(coder, stream_vbyte_bits) { test_bits<StreamVByteCoder>(); }
+TEST(coder, stream_vbyte_int) { test_int<StreamVByteCoder>(); }
+TEST(coder, stream_vbyte_str) { test_str<StreamVByteCoder>(); }
+TEST(coder, stream_vbyte_mixed) { test_mixed<StreamVByteCoder>(); }
+
+TEST(coder, rans_mt) { test_mt<RANSCoder>(); }
+TEST(coder, rans_bits) { test_bits<RANSCoder>(); }
+TEST(coder, rans_int) { test_int<RANSCoder>(); }
+TEST(coder, rans_str) { test_str<RANSCoder>(); }
+TEST(coder, rans_mixed) { test_mixed<RANSCoder>(); }
+
+TEST(coder, rans_literal_order) {
+    std::stringstream ss;
+    Output out(ss);
+    RANSCoder::Encoder coder(create_env(RANSCoder::meta()), out, ViewLiterals("abc"));
+
+    coder.encode('a', literal_r);
+    ASSERT_THROW(coder.encode('c', literal_r), std::logic_error);
+    coder.encode('b', literal_r);
+    coder.encode('c', literal_r);
+    ASSERT_THROW(coder.encode('d', literal_r), std::logic_error);
+}
+
+TEST(coder, rans_blocks) {
+    // Encode a text spanning multiple blocks, interleaved with other values
+    std::string word = RandomUniformGenerator::generate(150000, 7, 'a', 'z');
+    word += FibonacciGenerator::generate(20);
+
+    std::stringstream ss;
+    {
+        Output out(ss);
+        RANSCoder::Encoder coder(create_env(RANSCoder::meta()), out, ViewLiterals(word));
+
+        for(size_t i = 0; i < word.length(); i++) {
+            coder.encode(word[i], literal_r);
+            if(i % 1000 == 0) coder.encode(i, size_r);
+        }
+    }
+
+    std::string result = ss.str();
+    {
+        Input in(result);
+        RANSCoder::Decoder decoder(create_env(RANSCoder::meta()), in);
+
+        size_t i = 0;
+        while(!decoder.eof()) {
+            ASSERT_EQ(uliteral_t(word[i]), decoder.template decode<uliteral_t>(literal_r)) << "i=" << i;
+            if(i % 1000 == 0) ASSERT_EQ(i, decoder.template decode<size_t>(size_r));
+            ++i;
+        }
+
+        ASSERT_EQ(word.length(), i);
+    }
+}
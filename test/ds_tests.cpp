@@ -1,3 +1,6 @@
+#include <dirent.h>
+
+#include <random>
 #include <string>
 #include <vector>
 
@@ -7,8 +10,15 @@
 
 #include <tudocomp/io.hpp>
 #include <tudocomp/ds/TextDS.hpp>
+#include <tudocomp/ds/SAParallel.hpp>
+#include <tudocomp/ds/PhiParallel.hpp>
+#include <tudocomp/ds/PLCPParallel.hpp>
+#include <tudocomp/ds/LCPParallel.hpp>
+#include <tudocomp/ds/SAExternal.hpp>
+#include <tudocomp/ds/LCPExternal.hpp>
 #include <tudocomp/ds/uint_t.hpp>
 #include <tudocomp/ds/bwt.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
 #include <tudocomp/CreateAlgorithm.hpp>
 #include "test/util.hpp"
 
@@ -112,27 +122,52 @@ void test_lcp(const std::string& str, textds_t& t) {
 	}
 }
 
+template<class textds_t>
+void test_psv_nsv(const std::string& str, textds_t& t) {
+    auto& psv = t.require_psv();
+    auto& nsv = t.require_nsv();
+    auto& sa  = t.require_sa(); //request afterwards!
+    const size_t size = t.size();
+
+    ASSERT_EQ(psv.size(), size); //length
+    ASSERT_EQ(nsv.size(), size); //length
+
+    //correctness
+    for(size_t i = 0; i < size; ++i) {
+        size_t p = i;
+        while(p > 0 && sa[p-1] > sa[i]) --p;
+        ASSERT_EQ(psv[i], (p > 0) ? p-1 : size) << "at i=" << i;
+
+        size_t n = i + 1;
+        while(n < size && sa[n] > sa[i]) ++n;
+        ASSERT_EQ(nsv[i], n) << "at i=" << i;
+    }
+}
+
 template<class textds_t>
 void test_all_ds(const std::string& str, textds_t& t) {
     test_sa(str, t);
     test_bwt(str,t);
     test_lcp(str, t);
     test_isa(str, t);
+    test_psv_nsv(str, t);
 }
 
 template<class textds_t>
 class RunTestDS {
 	void (*m_testfunc)(const std::string&, textds_t&);
+	std::string m_options;
 	public:
-	RunTestDS(void (*testfunc)(const std::string&, textds_t&))
-		: m_testfunc(testfunc) {}
+	RunTestDS(void (*testfunc)(const std::string&, textds_t&),
+	          const std::string& options = "")
+		: m_testfunc(testfunc), m_options(options) {}
 
 	void operator()(const std::string& str) {
 		VLOG(2) << "str = \"" << str << "\"" << " size: " << str.length();
 		test::TestInput input = test::compress_input(str);
 		InputView in = input.as_view();
 		DCHECK_EQ(str.length()+1, in.size());
-		textds_t t = create_algo<textds_t>("", in);
+		textds_t t = create_algo<textds_t>(m_options, in);
 		DCHECK_EQ(str.length()+1, t.size());
 		m_testfunc(str, t);
 	}
@@ -146,6 +181,167 @@ TEST(ds, SA)          { TEST_DS_STRINGCOLLECTION(test_sa); }
 TEST(ds, BWT)         { TEST_DS_STRINGCOLLECTION(test_bwt); }
 TEST(ds, LCP)         { TEST_DS_STRINGCOLLECTION(test_lcp); }
 TEST(ds, ISA)         { TEST_DS_STRINGCOLLECTION(test_isa); }
+TEST(ds, PSVNSV)      { TEST_DS_STRINGCOLLECTION(test_psv_nsv); }
 TEST(ds, Integration) { TEST_DS_STRINGCOLLECTION(test_all_ds); }
 #undef TEST_DS_STRINGCOLLECTION
 
+template<class textds_t>
+void test_sa_equal(const std::string& str, textds_t& t) {
+    auto& sa = t.require_sa();
+
+    test::TestInput input = test::compress_input(str);
+    InputView in = input.as_view();
+    TextDS<> ref = create_algo<TextDS<>>("", in);
+    auto& ref_sa = ref.require_sa();
+
+    ASSERT_EQ(ref_sa.size(), sa.size());
+    for(size_t i = 0; i < sa.size(); i++) {
+        ASSERT_EQ(ref_sa[i], sa[i]) << "at i=" << i;
+    }
+}
+
+template<class textds_t>
+void test_phi_plcp(const std::string& str, textds_t& t) {
+    auto& sa = t.require_sa();
+    const size_t size = t.size();
+
+    {
+        auto& phi = t.require_phi();
+        ASSERT_EQ(phi.size(), size);
+        ASSERT_EQ(phi[sa[0]], sa[size-1]);
+        for(size_t i = 1; i < size; ++i) {
+            ASSERT_EQ(phi[sa[i]], sa[i-1]) << "at i=" << i;
+        }
+    }
+
+    // PLCP consumes Phi
+    auto& plcp = t.require_plcp();
+    ASSERT_EQ(plcp.size(), size);
+
+    size_t max = 0;
+    for(size_t i = 1; i < size; ++i) {
+        const size_t l = longest_common_extension(str, sa[i], sa[i-1]);
+        ASSERT_EQ(plcp[sa[i]], l) << "at i=" << i;
+        max = std::max(max, l);
+    }
+    ASSERT_EQ(plcp.max_lcp(), max);
+}
+
+#define TEST_DS_STRINGCOLLECTION(textds_t, options, func) \
+	RunTestDS<textds_t> runner(func, options); \
+	test::roundtrip_batch(runner); \
+	test::on_string_generators(runner,11);
+TEST(ds, SAParallel) {
+    TEST_DS_STRINGCOLLECTION(TextDS<SAParallel>, "sa=parallel(threads=4)", test_sa_equal);
+}
+TEST(ds, SAParallelIntegration) {
+    TEST_DS_STRINGCOLLECTION(TextDS<SAParallel>, "sa=parallel(threads=2)", test_all_ds);
+}
+
+using TextDSParallelPLCP = TextDS<SADivSufSort, PhiParallel, PLCPParallel>;
+using TextDSParallel = TextDS<SAParallel, PhiParallel, PLCPParallel, LCPParallel>;
+TEST(ds, PLCPParallel) {
+    TEST_DS_STRINGCOLLECTION(TextDSParallelPLCP,
+        "phi=parallel(threads=3),plcp=parallel(threads=3)", test_phi_plcp);
+}
+TEST(ds, LCPParallelIntegration) {
+    TEST_DS_STRINGCOLLECTION(TextDSParallel,
+        "sa=parallel(threads=2),phi=parallel(threads=2),"
+        "plcp=parallel(threads=2),lcp=parallel(threads=2)", test_all_ds);
+}
+
+using TextDSExternal = TextDS<SAExternal, PhiFromSA, PLCPFromPhi, LCPExternal>;
+TEST(ds, ExternalIntegration) {
+    test::create_test_directory();
+    TEST_DS_STRINGCOLLECTION(TextDSExternal,
+        "sa=external(scratch=\"" + test::test_file_path("") + "\"),"
+        "lcp=external(scratch=\"" + test::test_file_path("") + "\")", test_all_ds);
+}
+#undef TEST_DS_STRINGCOLLECTION
+
+
+template<class textds_t>
+void test_ds_equal(const std::string& str, const std::string& options) {
+    test::TestInput input = test::compress_input(str);
+    InputView in = input.as_view();
+
+    TextDS<> ref = create_algo<TextDS<>>("", in);
+    auto& ref_sa = ref.require_sa();
+    auto& ref_lcp = ref.require_lcp();
+    auto& ref_isa = ref.require_isa();
+
+    textds_t t = create_algo<textds_t>(options, in,
+        ds::SA | ds::LCP | ds::PLCP | ds::ISA);
+    auto& sa = t.require_sa();
+    auto& lcp = t.require_lcp();
+    auto& isa = t.require_isa();
+
+    ASSERT_EQ(ref_sa.size(), sa.size());
+    ASSERT_EQ(ref_lcp.max_lcp(), lcp.max_lcp());
+    for(size_t i = 0; i < sa.size(); i++) {
+        ASSERT_EQ(ref_sa[i], sa[i]) << "at i=" << i;
+        ASSERT_EQ(ref_lcp[i], lcp[i]) << "at i=" << i;
+        ASSERT_EQ(ref_isa[i], isa[i]) << "at i=" << i;
+    }
+}
+
+TEST(ds, Cache) {
+    test::create_test_directory();
+    const std::string dir = test::test_file_path("ds_cache");
+    mkdir(dir.c_str(), 0777);
+
+    const std::string text = "abracadabra_abracadabra_banana";
+    const std::string path = DSCache(dir, View(text + '\0')).path("sa", "divsufsort");
+    remove(path.c_str());
+
+    // first run stores the arrays, the second one loads them
+    for(const std::string cm : { "delayed", "plain", "compressed" }) {
+        test_ds_equal<TextDS<>>(text,
+            "compress=\"" + cm + "\",cache=\"" + dir + "\"");
+        ASSERT_TRUE(test::test_file_exists("ds_cache/" + path.substr(dir.size() + 1)));
+    }
+
+    // a different algorithm is stored separately
+    test_ds_equal<TextDS<SAParallel>>(text,
+        "sa=parallel(threads=2),cache=\"" + dir + "\"");
+
+    // damaged files are ignored
+    {
+        std::ofstream out(path, std::ios::out | std::ios::binary);
+        out << "damaged";
+    }
+    test_ds_equal<TextDS<>>(text, "cache=\"" + dir + "\"");
+}
+
+TEST(ds, ExternalBudget) {
+    test::create_test_directory();
+    const std::string dir = test::test_file_path("ds_external");
+    mkdir(dir.c_str(), 0777);
+
+    // mutated copies of a random block, large enough to exceed the budget
+    std::string text(600000, 'a');
+    {
+        // the random block, followed by the characters of the mutations
+        const std::string chars = RandomUniformGenerator::generate(5500, 600000, 'a', 'z');
+        std::default_random_engine rnd(600000);
+        std::uniform_int_distribution<size_t> gen_pos(0, text.size() - 1);
+
+        for(size_t i = 0; i < 5000; ++i) text[i] = chars[i];
+        for(size_t i = 5000; i < text.size(); ++i) text[i] = text[i - 5000];
+        for(size_t k = 0; k < 500; ++k) text[gen_pos(rnd)] = chars[5000 + k];
+    }
+
+    const std::string scratch = "scratch=\"" + dir + "\",budget=1";
+    test_ds_equal<TextDSExternal>(text,
+        "sa=external(" + scratch + "),lcp=external(" + scratch + ")");
+
+    // all scratch files have been removed
+    DIR* d = opendir(dir.c_str());
+    ASSERT_NE(nullptr, d);
+    size_t files = 0;
+    while(dirent* e = readdir(d)) {
+        if(e->d_name[0] != '.') ++files;
+    }
+    closedir(d);
+    ASSERT_EQ(0U, files);
+}
@@ -4,6 +4,7 @@
 #include <cstring>
 #include <bitset>
 #include <algorithm>
+#include <random>
 #include <tudocomp/coders/HuffmanCoder.hpp>
 
 void test_huffmantable_storing(const std::string& text) {
@@ -136,6 +137,22 @@ TEST(huffman, stringgenerators) {
 //
 // }
 
+TEST(huff, long_codewords) {
+	// Fibonacci frequencies yield codewords longer than the lookup table
+	std::string text;
+	size_t a = 1, b = 1;
+	for(char c = 'a'; c < 'a' + 20; ++c) {
+		text += std::string(a, c);
+		std::swap(a, b);
+		b += a;
+	}
+	std::shuffle(text.begin(), text.end(), std::mt19937(1));
+
+	tdc::huff::extended_huffmantable table = tdc::huff::gen_huffmantable(text);
+	ASSERT_GT(table.longest, tdc::huff::max_lookup_bits);
+	test_huff(text);
+}
+
 TEST(huff, nullbyte) {
     test_huff("hel\0lo"_v);
     test_huff("hello\0"_v);
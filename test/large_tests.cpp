@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <glog/logging.h>
+
+#include <random>
+
+#include <tudocomp/io.hpp>
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/ds/TextDS.hpp>
+
+#include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/compressors/LCPCompressor.hpp>
+#include <tudocomp/compressors/lcpcomp/compress/ArraysComp.hpp>
+#include <tudocomp/compressors/lcpcomp/compress/MaxLCPStrategy.hpp>
+#include <tudocomp/compressors/lcpcomp/decompress/CompactDec.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+
+#include "test/util.hpp"
+
+using namespace tdc;
+
+// These tests are only built in the 64-bit mode (pass -DLEN_64=1 to CMake).
+static_assert(sizeof(len_t) == 8, "large_tests require 64-bit text positions");
+
+constexpr size_t GiB = size_t(1) << 30;
+constexpr size_t MiB = size_t(1) << 20;
+
+/// Generates a text of length n (excluding the sentinel) that consists of
+/// randomly mutated copies of a random block, so that lcpcomp finds long
+/// factors reaching beyond the 32-bit boundary.
+std::vector<uint8_t> generate_large_text(const size_t n, const size_t block) {
+    const size_t copies = idiv_ceil(n, block) - 1;
+
+    // the random block, followed by the characters of the mutations
+    const std::string chars = RandomUniformGenerator::generate(
+        block + 4 * copies, n, 'a', 'z');
+
+    std::default_random_engine rnd(n);
+    std::uniform_int_distribution<size_t> gen_pos(0, block - 1);
+
+    std::vector<uint8_t> text(n);
+    std::copy(chars.begin(), chars.begin() + block, text.begin());
+
+    size_t next = block;
+    for(size_t p = block; p < n; p += block) {
+        const size_t len = std::min(block, n - p);
+        std::copy(text.begin(), text.begin() + len, text.begin() + p);
+
+        // mutate a few characters in every copy
+        for(size_t k = 0; k < 4; ++k) {
+            const size_t i = gen_pos(rnd);
+            const uint8_t c = chars[next++];
+            if(i < len) text[p + i] = c;
+        }
+    }
+    return text;
+}
+
+TEST(large, len_t) {
+    ASSERT_EQ(64U, LEN_BITS);
+    ASSERT_EQ(std::numeric_limits<uint64_t>::max(), LEN_MAX);
+}
+
+TEST(large, factor_buffer) {
+    const len_t base = len_t(5) * GiB;
+
+    lzss::FactorBuffer buf;
+    buf.emplace_back(base + 2, base, len_t(4) * GiB + 1);
+    buf.emplace_back(base + 1, 7, 3);
+    buf.sort();
+
+    ASSERT_EQ(base + 1, buf[0].pos);
+    ASSERT_EQ(len_t(7), buf[0].src);
+    ASSERT_EQ(base, buf[1].src);
+    ASSERT_EQ(len_t(4) * GiB + 1, buf[1].len);
+    ASSERT_EQ(size_t(3), buf.shortest_factor());
+    ASSERT_EQ(len_t(4) * GiB + 1, buf.longest_factor());
+}
+
+TEST(large, coder_ranges) {
+    const len_t a = len_t(6) * GiB + 17;
+    const len_t b = len_t(1) << 63;
+
+    std::vector<uint8_t> encoded;
+    {
+        Output out = Output::from_memory(encoded);
+        BitCoder::Encoder coder(create_env(BitCoder::meta()), out, NoLiterals());
+        coder.encode(a, len_r);
+        coder.encode(b, len_r);
+        coder.encode(a, Range(a - 1, a + 1));
+        coder.encode(a, MinDistributedRange(a));
+    }
+    {
+        Input in = Input::from_memory(encoded);
+        BitCoder::Decoder decoder(create_env(BitCoder::meta()), in);
+        ASSERT_EQ(a, decoder.template decode<len_t>(len_r));
+        ASSERT_EQ(b, decoder.template decode<len_t>(len_r));
+        ASSERT_EQ(a, decoder.template decode<len_t>(Range(a - 1, a + 1)));
+        ASSERT_EQ(a, decoder.template decode<len_t>(MinDistributedRange(a)));
+    }
+}
+
+TEST(large, lcpcomp_roundtrip) {
+    using compressor_t = LCPCompressor<
+        BitCoder, lcpcomp::ArraysComp, lcpcomp::CompactDec, TextDS<>>;
+
+    // 4 GiB plus one block, i.e., well beyond what 32-bit positions can address
+    const size_t n = 4 * GiB + MiB;
+    const std::vector<uint8_t> text = generate_large_text(n, MiB);
+
+    std::vector<uint8_t> compressed;
+    {
+        Input in = Input::from_memory(text);
+        in = Input(in, compressor_t::meta().textds_flags());
+        Output out = Output::from_memory(compressed);
+
+        auto compressor = create_algo<compressor_t>();
+        compressor.compress(in, out);
+    }
+    ASSERT_LT(compressed.size(), n / 64);
+
+    std::vector<uint8_t> decompressed;
+    {
+        Input in = Input::from_memory(compressed);
+        Output out = Output::from_memory(decompressed);
+        out = Output(out, compressor_t::meta().textds_flags());
+
+        auto compressor = create_algo<compressor_t>();
+        compressor.decompress(in, out);
+    }
+
+    ASSERT_EQ(text.size(), decompressed.size());
+    ASSERT_TRUE(text == decompressed);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <glog/logging.h>
+
+#include <random>
+
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/ds/TextDS.hpp>
+
+#include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/AdaptiveArithmeticCoder.hpp>
+#include <tudocomp/coders/HuffmanCoder.hpp>
+#include <tudocomp/coders/SLECoder.hpp>
+#include <tudocomp/coders/SplitCoder.hpp>
+#include <tudocomp/compressors/LCPCompressor.hpp>
+#include <tudocomp/compressors/lcpcomp/compress/ArraysComp.hpp>
+#include <tudocomp/compressors/lcpcomp/compress/ArraysCompParallel.hpp>
+#include <tudocomp/compressors/lcpcomp/compress/MaxLCPStrategy.hpp>
+#include <tudocomp/compressors/lcpcomp/decompress/CompactDec.hpp>
+#include <tudocomp/compressors/lcpcomp/decompress/ParallelDec.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+
+#include "test/util.hpp"
+
+using namespace tdc;
+
+/// Generates a text consisting of randomly mutated copies of a random block.
+std::string generate_repetitive_text(const size_t n, const size_t block, const size_t seed) {
+    // the random block, followed by the characters of the mutations
+    // (a zero seed would make the generator seed itself from the clock)
+    const std::string chars = RandomUniformGenerator::generate(
+        block + n / block, seed + 1, 'a', 'd');
+    std::default_random_engine rnd(seed);
+    std::uniform_int_distribution<size_t> gen_pos(0, n - 1);
+
+    std::string text(n, 0);
+    for(size_t i = 0; i < n; ++i) {
+        text[i] = (i < block) ? chars[i] : text[i - block];
+    }
+    for(size_t k = 0; k < n / block; ++k) text[gen_pos(rnd)] = chars[block + k];
+    return text;
+}
+
+template<typename strategy_t>
+using lcpcomp_t = LCPCompressor<ASCIICoder, strategy_t, lcpcomp::CompactDec, TextDS<>>;
+
+TEST(lcpcomp, ArraysCompParallel) {
+    auto roundtrip = [](const std::string& s){
+        test::roundtrip_ex<lcpcomp_t<lcpcomp::ArraysCompParallel>>(s, "",
+            "comp=arrays_parallel(threads=3)");
+    };
+    test::roundtrip_batch(roundtrip);
+    test::on_string_generators(roundtrip, 11);
+
+    for(size_t seed = 0; seed < 4; ++seed) {
+        roundtrip(generate_repetitive_text(100000, 1000 << seed, seed));
+    }
+}
+
+TEST(lcpcomp, ArraysCompParallelDeterministic) {
+    // long repetitions so that LCP values are processed in parallel
+    const std::string text = generate_repetitive_text(200000, 20000, 7);
+
+    auto compress = [&](const std::string& options){
+        return test::compress<lcpcomp_t<lcpcomp::ArraysCompParallel>>(text, options).bytes;
+    };
+
+    const auto sequential = compress("comp=arrays_parallel(threads=1)");
+    ASSERT_EQ(sequential, compress("comp=arrays_parallel(threads=2)"));
+    ASSERT_EQ(sequential, compress("comp=arrays_parallel(threads=5)"));
+
+    // compresses as well as the sequential strategy
+    const auto reference = test::compress<lcpcomp_t<lcpcomp::ArraysComp>>(text).bytes;
+    ASSERT_LE(sequential.size(), reference.size() + reference.size() / 10);
+}
+
+TEST(lcpcomp, ParallelDec) {
+    using compressor_t = LCPCompressor<ASCIICoder, lcpcomp::ArraysComp,
+        lcpcomp::ParallelDec, TextDS<>>;
+
+    // zero rounds decode everything sequentially, one round leaves the
+    // remainder to the sequential decoding
+    for(const std::string rounds : { "0", "1", "64" }) {
+        auto roundtrip = [&](const std::string& s){
+            test::roundtrip_ex<compressor_t>(s, "",
+                "comp=arrays(),dec=parallel(threads=3,max_rounds=" + rounds + ")");
+        };
+        test::roundtrip_batch(roundtrip);
+        test::on_string_generators(roundtrip, 11);
+
+        for(size_t seed = 0; seed < 4; ++seed) {
+            roundtrip(generate_repetitive_text(100000, 1000 << seed, seed));
+        }
+    }
+}
+
+TEST(lcpcomp, Blocks) {
+    using compressor_t = lcpcomp_t<lcpcomp::ArraysComp>;
+
+    for(const std::string block_size : { "1", "7", "1000" }) {
+        auto roundtrip = [&](const std::string& s){
+            test::roundtrip_ex<compressor_t>(s, "",
+                "comp=arrays(),block_size=" + block_size + ",threads=3");
+        };
+        test::roundtrip_batch(roundtrip);
+        test::on_string_generators(roundtrip, 11);
+    }
+
+    const std::string text = generate_repetitive_text(100000, 3000, 3);
+    for(const std::string block_size : { "4096", "99999", "100000", "1000000" }) {
+        test::roundtrip_ex<compressor_t>(text, "",
+            "comp=arrays(),block_size=" + block_size + ",threads=2");
+    }
+}
+
+TEST(lcpcomp, BlocksDeterministic) {
+    using compressor_t = lcpcomp_t<lcpcomp::ArraysComp>;
+    const std::string text = generate_repetitive_text(100000, 3000, 5);
+
+    auto compress = [&](const std::string& options){
+        return test::compress<compressor_t>(text, "comp=arrays()," + options).bytes;
+    };
+
+    const auto sequential = compress("block_size=8192,threads=1");
+    ASSERT_EQ(sequential, compress("block_size=8192,threads=4"));
+
+    // a single block only adds the index to the regular output
+    const auto whole = compress("block_size=0");
+    const auto single = compress("block_size=1000000");
+    ASSERT_EQ(whole.size() + 16, single.size());
+    ASSERT_TRUE(std::equal(whole.begin(), whole.end(), single.begin()));
+}
+
+TEST(lcpcomp, AdaptiveArithmeticCoder) {
+    using compressor_t = LCPCompressor<AdaptiveArithmeticCoder,
+        lcpcomp::ArraysComp, lcpcomp::CompactDec, TextDS<>>;
+
+    auto roundtrip = [&](const std::string& s){
+        test::roundtrip_ex<compressor_t>(s, "", "comp=arrays()");
+    };
+    test::roundtrip_batch(roundtrip);
+    test::on_string_generators(roundtrip, 11);
+
+    // the adaptive model beats the static SLE coder on the factor fields
+    const std::string text = generate_repetitive_text(100000, 3000, 7);
+    roundtrip(text);
+
+    using sle_t = LCPCompressor<SLECoder,
+        lcpcomp::ArraysComp, lcpcomp::CompactDec, TextDS<>>;
+    ASSERT_LT(test::compress<compressor_t>(text, "comp=arrays()").bytes.size(),
+              test::compress<sle_t>(text, "comp=arrays()").bytes.size());
+}
+
+TEST(lcpcomp, SplitCoder) {
+    using coder_t = SplitCoder<HuffmanCoder, AdaptiveArithmeticCoder,
+        AdaptiveArithmeticCoder, AdaptiveArithmeticCoder>;
+    using compressor_t = LCPCompressor<coder_t,
+        lcpcomp::ArraysComp, lcpcomp::CompactDec, TextDS<>>;
+
+    auto roundtrip = [&](const std::string& s){
+        test::roundtrip_ex<compressor_t>(s, "", "comp=arrays()");
+    };
+    test::roundtrip_batch(roundtrip);
+    test::on_string_generators(roundtrip, 11);
+    roundtrip(generate_repetitive_text(100000, 3000, 11));
+}
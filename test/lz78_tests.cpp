@@ -0,0 +1,134 @@
+#include "test/util.hpp"
+#include <gtest/gtest.h>
+#include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/compressors/LZ78Compressor.hpp>
+#include <tudocomp/compressors/LZWCompressor.hpp>
+#include <tudocomp/compressors/lz78/BinaryTrie.hpp>
+#include <tudocomp/compressors/lz78/BinarySortedTrie.hpp>
+#include <tudocomp/compressors/lz78/TernaryTrie.hpp>
+#include <tudocomp/compressors/lz78/HashTrie.hpp>
+#include <tudocomp/compressors/lz78/MyHashTrie.hpp>
+#include <tudocomp/compressors/lz78/CompactHashTrie.hpp>
+#include <tudocomp/compressors/lz78/CedarTrie.hpp>
+#include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+
+using namespace tdc;
+
+template<class dict_t>
+void test_clear() {
+    dict_t dict(create_env(dict_t::meta()));
+
+    for(size_t round = 0; round < 3; round++) {
+        dict.clear();
+        auto root = dict.add_rootnode(0);
+        ASSERT_EQ(1U, dict.size());
+
+        // insert "ab" and find it again
+        ASSERT_EQ(lz78::undef_id, dict.find_or_insert(root, 'a').id());
+        auto a = dict.find_or_insert(dict.get_rootnode(0), 'a');
+        ASSERT_EQ(1U, a.id());
+        ASSERT_EQ(lz78::undef_id, dict.find_or_insert(a, 'b').id());
+        ASSERT_EQ(3U, dict.size());
+    }
+}
+
+TEST(lz78trie, binary_clear) { test_clear<lz78::BinaryTrie>(); }
+TEST(lz78trie, binarysorted_clear) { test_clear<lz78::BinarySortedTrie>(); }
+TEST(lz78trie, ternary_clear) { test_clear<lz78::TernaryTrie>(); }
+TEST(lz78trie, hash_clear) { test_clear<lz78::HashTrie>(); }
+TEST(lz78trie, myhash_clear) { test_clear<lz78::MyHashTrie>(); }
+TEST(lz78trie, compact_hash_clear) { test_clear<lz78::CompactHashTrie>(); }
+TEST(lz78trie, cedar_clear) { test_clear<lz78::CedarTrie>(); }
+
+TEST(lz78, dict_reset) {
+    // the dictionary is reset after the factors "a", "b" and "c"
+    test::roundtrip_ex<LZ78Compressor<ASCIICoder, lz78::BinaryTrie>>(
+        "abcabcab", "0:a0:b0:c0:a0:b0:c0:a0:b\0"_v, "dict_size = \"4\"");
+}
+
+TEST(lzw, dict_reset) {
+    // the dictionary is reset after the factors "a", "b" and "ab"
+    test::roundtrip_ex<LZWCompressor<ASCIICoder, lz78::BinaryTrie>>(
+        "abababab", "97:98:256:97:98:256:\0"_v, "dict_size = \"259\"");
+}
+
+TEST(lzw, dict_size_too_small) {
+    // the dictionary cannot hold the initial alphabet
+    for(auto size : {"1", "100", "256"}) {
+        ASSERT_THROW((create_algo<LZWCompressor<ASCIICoder, lz78::BinaryTrie>>(
+            std::string("dict_size = \"") + size + "\"")), std::runtime_error) << size;
+    }
+}
+
+template<class compressor_t>
+void test_dict_sizes(const std::vector<std::string>& sizes) {
+    const std::string text = RandomUniformGenerator::generate(5000, 4, 'a', 'd');
+
+    for(auto& size : sizes) {
+        test::roundtrip_ex<compressor_t>(text, "", "dict_size = \"" + size + "\"");
+        test::roundtrip_batch([&](std::string str) {
+            test::roundtrip_ex<compressor_t>(str, "", "dict_size = \"" + size + "\"");
+        });
+    }
+}
+
+template<class dict_t>
+void test_lz78_dict_sizes() {
+    test_dict_sizes<LZ78Compressor<BitCoder, dict_t>>({"2", "3", "17", "1000", "inf"});
+}
+
+template<class dict_t>
+void test_lzw_dict_sizes() {
+    test_dict_sizes<LZWCompressor<BitCoder, dict_t>>({"257", "258", "300", "1000", "inf", "0"});
+}
+
+TEST(lz78, binary_dict_sizes) { test_lz78_dict_sizes<lz78::BinaryTrie>(); }
+TEST(lz78, binarysorted_dict_sizes) { test_lz78_dict_sizes<lz78::BinarySortedTrie>(); }
+TEST(lz78, ternary_dict_sizes) { test_lz78_dict_sizes<lz78::TernaryTrie>(); }
+TEST(lz78, hash_dict_sizes) { test_lz78_dict_sizes<lz78::HashTrie>(); }
+TEST(lz78, myhash_dict_sizes) { test_lz78_dict_sizes<lz78::MyHashTrie>(); }
+TEST(lz78, compact_hash_dict_sizes) { test_lz78_dict_sizes<lz78::CompactHashTrie>(); }
+TEST(lz78, cedar_dict_sizes) { test_lz78_dict_sizes<lz78::CedarTrie>(); }
+
+TEST(lzw, binary_dict_sizes) { test_lzw_dict_sizes<lz78::BinaryTrie>(); }
+TEST(lzw, binarysorted_dict_sizes) { test_lzw_dict_sizes<lz78::BinarySortedTrie>(); }
+TEST(lzw, ternary_dict_sizes) { test_lzw_dict_sizes<lz78::TernaryTrie>(); }
+TEST(lzw, hash_dict_sizes) { test_lzw_dict_sizes<lz78::HashTrie>(); }
+TEST(lzw, myhash_dict_sizes) { test_lzw_dict_sizes<lz78::MyHashTrie>(); }
+TEST(lzw, compact_hash_dict_sizes) { test_lzw_dict_sizes<lz78::CompactHashTrie>(); }
+TEST(lzw, cedar_dict_sizes) { test_lzw_dict_sizes<lz78::CedarTrie>(); }
+
+TEST(lz78trie, compact_hash_growth) {
+    // compare against a reference trie while the table grows
+    lz78::CompactHashTrie dict(create_env(lz78::CompactHashTrie::meta()));
+    lz78::BinaryTrie ref(create_env(lz78::BinaryTrie::meta()));
+
+    const std::string text = RandomUniformGenerator::generate(200000, 5, 1, 127);
+    for(size_t round = 0; round < 2; round++) {
+        dict.clear();
+        ref.clear();
+        dict.add_rootnode(0);
+        ref.add_rootnode(0);
+
+        lz78::TrieNode<lz78::factorid_t> node = 0;
+        for(char c : text) {
+            auto child = dict.find_or_insert(node, uliteral_t(c));
+            ASSERT_EQ(ref.find_or_insert(node, uliteral_t(c)).id(), child.id());
+            node = (child.id() == lz78::undef_id) ? dict.get_rootnode(0) : child;
+        }
+        ASSERT_EQ(ref.size(), dict.size());
+    }
+}
+
+TEST(lz78, compact_hash_load_factors) {
+    // nodes are inserted while the table migrates over several growths
+    for(auto lf : {"90", "95"}) {
+        for(size_t seed = 0; seed < 4; seed++) {
+            const std::string text = RandomUniformGenerator::generate(300000, seed, 1, 255);
+            test::roundtrip_ex<LZ78Compressor<BitCoder, lz78::CompactHashTrie>>(
+                text, "", std::string("lz78trie = compact_hash(load_factor = \"") + lf + "\")");
+        }
+    }
+}
@@ -1,6 +1,8 @@
+#include <set>
 #include "test/util.hpp"
 #include <gtest/gtest.h>
 
+#include <tudocomp/CreateAlgorithm.hpp>
 #include <tudocomp/compressors/LZ78UCompressor.hpp>
 #include <tudocomp/compressors/lz78u/BufferingStrategy.hpp>
 #include <tudocomp/compressors/lz78u/StreamingStrategy.hpp>
@@ -180,3 +182,45 @@ TEST(Lz78U, roundtrip3) {
         }
     );
 }
+
+TEST(Lz78U, lcp_interval_tree) {
+    test::roundtrip_batch([](const std::string& str) {
+        test::TestInput input = test::compress_input(str);
+        auto T = input.as_view();
+        auto st = create_algo<LCPIntervalTree<>>("", T);
+
+        for(len_t pos = 0; pos < T.size(); pos++) {
+            // the string depths of the ancestors of a leaf are the lengths
+            // of the common prefixes with the other suffixes, and the root
+            std::set<len_t> lces { 0 };
+            for(len_t j = 0; j < T.size(); j++) {
+                len_t l = 0;
+                while(j != pos && T[pos + l] == T[j + l]) ++l;
+                if(j != pos) lces.insert(l);
+            }
+
+            std::set<len_t> depths;
+            const auto leaf = st.leaf(pos);
+            for(auto v = st.root(); !st.is_leaf(v); v = st.child(v, leaf)) {
+                ASSERT_LT(st.nid(v), st.internal_nodes());
+                depths.insert(st.str_depth(v));
+            }
+            ASSERT_EQ(lces, depths) << "at pos=" << pos;
+        }
+    });
+}
+
+TEST(Lz78U, lcp_intervals_roundtrip) {
+    // both suffix tree representations yield the same factorization
+    auto roundtrip = [](const std::string& str) {
+        auto sada = test::compress<LZ78UCompressor<
+            StreamingStrategy<ASCIICoder>, ASCIICoder, CSTSada>>(str);
+        auto lcp = test::compress<LZ78UCompressor<
+            StreamingStrategy<ASCIICoder>, ASCIICoder, LCPIntervalTree<>>>(str);
+
+        lcp.assert_decompress();
+        ASSERT_EQ(sada.bytes, lcp.bytes);
+    };
+    test::roundtrip_batch(roundtrip);
+    test::on_string_generators(roundtrip, 11);
+}
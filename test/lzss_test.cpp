@@ -1,3 +1,4 @@
+#include "test/util.hpp"
 #include <gtest/gtest.h>
 
 #include <tudocomp/Compressor.hpp>
@@ -7,6 +8,15 @@
 #include <tudocomp/compressors/lzss/LZSSCoding.hpp>
 #include <tudocomp/compressors/lzss/LZSSFactors.hpp>
 #include <tudocomp/compressors/lzss/LZSSLiterals.hpp>
+#include <tudocomp/compressors/lzss/LZSSSlidingWindow.hpp>
+#include <tudocomp/compressors/LZSSSlidingWindowCompressor.hpp>
+#include <tudocomp/compressors/LZSSLCPCompressor.hpp>
+#include <tudocomp/compressors/LZSSOptimalCompressor.hpp>
+#include <tudocomp/compressors/LZSSStreamCompressor.hpp>
+
+#include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
 
 #include <tudocomp/compressors/lcpcomp/decompress/CompactDec.hpp>
 #include <tudocomp/compressors/lcpcomp/decompress/DecodeQueueListBuffer.hpp>
@@ -205,3 +215,179 @@ TEST(lzss, decode_forward_ql_buffer_chain) {
 TEST(lzss, decode_forward_ql_buffer_multiref) {
     test_forward_decode_buffer_multiref<lcpcomp::DecodeForwardQueueListBuffer>();
 }
+
+TEST(lzss, decode_forward_ql_buffer_long_chain) {
+    // every position waits for its successor, so decoding the last
+    // character resolves a chain through the whole text
+    const len_t n = 1000000;
+    auto buffer = create_algo<lcpcomp::DecodeForwardQueueListBuffer>("", n);
+    buffer.decode_factor(1, n - 1);
+    buffer.decode_literal('a');
+    buffer.decode_eagerly();
+
+    ASSERT_EQ(n, buffer.longest_chain());
+
+    std::stringstream ss;
+    buffer.write_to(ss);
+    ASSERT_EQ(std::string(n, 'a'), ss.str());
+}
+
+TEST(lzss, sliding_window_longest) {
+    // exhaustive search, compared against a naive one
+    const size_t window = 50, max_len = 20, min_len = 3;
+    const std::string text = RandomUniformGenerator::generate(5000, 2, 'a', 'c');
+
+    lzss::SlidingWindow sw(window, max_len, min_len, window, max_len);
+    size_t next = 0;
+    for(size_t pos = 0; pos < text.size(); pos++) {
+        while(sw.can_push() && next < text.size()) sw.push(text[next++]);
+        ASSERT_EQ(pos, sw.pos());
+
+        size_t src = 0;
+        const size_t len = sw.find(src);
+
+        size_t ref = 0, ref_src = 0;
+        for(size_t k = (pos > window ? pos - window : 0); k < pos; k++) {
+            size_t j = 0;
+            while(j < max_len && pos + j < text.size() && text[k + j] == text[pos + j]) ++j;
+            if(j >= ref) { ref = j; ref_src = k; }
+        }
+
+        if(ref >= min_len) {
+            ASSERT_EQ(ref, len);
+            ASSERT_EQ(ref_src, src);
+        } else {
+            ASSERT_EQ(0U, len);
+        }
+
+        sw.advance(1);
+    }
+}
+
+TEST(lzss, sliding_window_factors) {
+    test::roundtrip_ex<LZSSSlidingWindowCompressor<ASCIICoder>>(
+        "abcabcabcx", "0a0b0c13:6:0x\0"_v);
+}
+
+TEST(lzss, sliding_window_empty) {
+    ASSERT_THROW(create_algo<LZSSSlidingWindowCompressor<ASCIICoder>>("window = \"0\""),
+        std::runtime_error);
+}
+
+TEST(lzss, sliding_window_roundtrip) {
+    const std::string text = RandomUniformGenerator::generate(20000, 3, 'a', 'e');
+
+    for(auto& options : std::vector<std::string>{
+            "", "window = \"1\"", "window = \"1000\"", "window = \"65536\"",
+            "threshold = \"0\"", "threshold = \"1\"", "threshold = \"10\"",
+            "max_chain = \"1\"", "nice_len = \"1\"", "max_chain = \"0\""}) {
+
+        test::roundtrip_ex<LZSSSlidingWindowCompressor<BitCoder>>(text, "", options);
+        test::roundtrip_batch([&](std::string str) {
+            test::roundtrip_ex<LZSSSlidingWindowCompressor<BitCoder>>(str, "", options);
+        });
+    }
+}
+
+TEST(lzss, optimal_factors) {
+    test::roundtrip_ex<LZSSOptimalCompressor<ASCIICoder>>(
+        "abcabcab", "9:5:5:3:13:abc0:5:11:\0\0"_v);
+}
+
+TEST(lzss, optimal_roundtrip) {
+    const std::string text = RandomUniformGenerator::generate(20000, 3, 'a', 'e');
+
+    for(auto& options : std::vector<std::string>{
+            "", "threshold = \"1\"", "threshold = \"5\"",
+            "block_size = \"1\"", "block_size = \"100\", threads = \"1\"",
+            "block_size = \"1000\", threads = \"4\""}) {
+
+        test::roundtrip_ex<LZSSOptimalCompressor<BitCoder>>(text, "", options);
+        test::roundtrip_batch([&](std::string str) {
+            test::roundtrip_ex<LZSSOptimalCompressor<BitCoder>>(str, "", options);
+        });
+    }
+}
+
+TEST(lzss, optimal_not_worse_than_greedy) {
+    std::vector<std::string> texts = {
+        RandomUniformGenerator::generate(20000, 4, 'a', 'c'),
+        RandomUniformGenerator::generate(20000, 5, 'a', 'z'),
+    };
+    test::roundtrip_batch([&](std::string str) { texts.push_back(str); });
+
+    using compressor_t = LZSSOptimalCompressor<BitCoder>;
+    for(auto& text : texts) {
+        test::TestInput input = test::compress_input(text);
+        auto view = input.as_view();
+        auto ds = create_algo<TextDS<>>("", view, TextDS<>::SA | TextDS<>::LCP);
+
+        // compare the shortest path alone, the greedy factorization is
+        // only its fallback
+        auto compressor = create_algo<compressor_t>();
+        lzss::FactorBuffer path, greedy;
+        compressor.factorize(ds, path, greedy);
+
+        ASSERT_LE(compressor_t::size_of(ds.size(), path),
+                  compressor_t::size_of(ds.size(), greedy)) << "text: " << text;
+    }
+}
+
+TEST(lzss, lcp_factors) {
+    test::roundtrip_ex<LZSSLCPCompressor<ASCIICoder>>(
+        "abcabcabcx", "11:6:6:3:13:abc0:6:12:x\0\0"_v);
+    test::roundtrip_ex<LZSSLCPCompressor<ASCIICoder>>(
+        "abcabcababcabc", "15:5:6:3:13:abc0:5:00:6:11:\0\0"_v);
+}
+
+TEST(lzss, lcp_repetitive) {
+    // long factors with many smaller values in between
+    std::string text;
+    for(size_t i = 0; i < 20; i++) {
+        text += std::string(1000, 'a') + char('b' + i % 3);
+    }
+    test::roundtrip<LZSSLCPCompressor<BitCoder>>(text);
+    test::roundtrip<LZSSLCPCompressor<BitCoder>>(std::string(50000, 'a'));
+}
+
+TEST(lzss, stream_factors) {
+    test::roundtrip_ex<LZSSStreamCompressor<ASCIICoder>>(
+        "abcabcabcx", "0a0b0c13:6:0x0\0\0"_v);
+
+    // factors do not cross blocks, and refer back at most one block
+    test::roundtrip_ex<LZSSStreamCompressor<ASCIICoder>>(
+        "abcabcabcx", "0a0b0c0a0b0c0a0b0c0x0\0\0"_v,
+        "window = \"0\", block_size = \"4\"");
+}
+
+TEST(lzss, stream_roundtrip) {
+    const std::string text = RandomUniformGenerator::generate(20000, 6, 'a', 'd');
+
+    for(auto& options : std::vector<std::string>{
+            "", "threshold = \"1\"", "window = \"0\", block_size = \"1\"",
+            "window = \"100\", block_size = \"7\"",
+            "window = \"1000\", block_size = \"3000\""}) {
+
+        test::roundtrip_ex<LZSSStreamCompressor<BitCoder>>(text, "", options);
+        test::roundtrip_batch([&](std::string str) {
+            test::roundtrip_ex<LZSSStreamCompressor<BitCoder>>(str, "", options);
+        });
+    }
+}
+
+TEST(lzss, stream_repetitive) {
+    std::string text;
+    const std::string block = RandomUniformGenerator::generate(1000, 7, 'a', 'z');
+    for(size_t i = 0; i < 100; i++) {
+        text += block;
+        text[text.size() - 1 - (i * 7) % block.size()] = 'A' + (i % 26);
+    }
+
+    // blocks much smaller than the text lose little compared to the
+    // factorization of the whole text
+    auto lcp = test::compress<LZSSLCPCompressor<BitCoder>>(text);
+    auto stream = test::compress<LZSSStreamCompressor<BitCoder>>(text,
+        "window = \"2000\", block_size = \"2000\"");
+    stream.assert_decompress();
+    ASSERT_LT(stream.bytes.size(), lcp.bytes.size() * 3 / 2);
+}
@@ -0,0 +1,46 @@
+#include "test/util.hpp"
+#include <gtest/gtest.h>
+#include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/compressors/RePairCompressor.hpp>
+#include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+
+using namespace tdc;
+
+TEST(repair, grammar) {
+    // A -> ab, B -> AA, S -> BB
+    test::roundtrip_ex<RePairCompressor<ASCIICoder>>("abababab", "2:0a0b10:10:11:11:\0"_v);
+}
+
+TEST(repair, runs) {
+    // overlapping occurrences of "aa" are counted once
+    // A -> aa, S -> AAAa
+    test::roundtrip_ex<RePairCompressor<ASCIICoder>>("aaaaaaa", "1:0a0a10:10:10:0a\0"_v);
+}
+
+TEST(repair, max_rules) {
+    test::roundtrip_ex<RePairCompressor<ASCIICoder>>("abababab", "1:0a0b10:10:10:10:\0"_v, "max_rules = \"1\"");
+}
+
+TEST(repair, roundtrip) {
+    test::roundtrip_batch(test::roundtrip<RePairCompressor<BitCoder>>);
+
+    for(size_t seed = 0; seed < 4; seed++) {
+        test::roundtrip<RePairCompressor<BitCoder>>(
+            RandomUniformGenerator::generate(10000, seed, 'a', 'a' + 3 * seed));
+    }
+}
+
+TEST(repair, repetitive) {
+    std::string text;
+    const std::string block = RandomUniformGenerator::generate(1000, 1, 'a', 'z');
+    for(size_t i = 0; i < 200; i++) {
+        text += block;
+        text[text.size() - 1 - (i * 7) % block.size()] = 'A' + (i % 26);
+    }
+
+    auto result = test::compress<RePairCompressor<BitCoder>>(text);
+    result.assert_decompress();
+    ASSERT_LT(result.bytes.size(), text.size() / 10);
+}
@@ -1,6 +1,6 @@
 # Grab gtest and microbenchmark support
 find_or_download_package(GTest GTEST gtest)
-#find_or_download_package(Benchpress BENCHPRESS benchpress)
+find_or_download_package(Benchpress BENCHPRESS benchpress)
 
 # Custom test target to run the googletest tests
 add_custom_target(check)
@@ -142,6 +142,7 @@ endmacro()
 macro(run_bench test_target)
 generic_run_test(
     ${test_target}
+    "${test_target}.cpp"
     "test/bench_driver.cpp"
     benchpress
     bench
@@ -149,4 +150,9 @@ generic_run_test(
     "Bench"
     ${ARGN}
 )
+
+# benchpress is header-only, so the download is not a dependency of a library
+if(TARGET benchpress_external)
+    add_dependencies(${test_target}_testrunner benchpress_external)
+endif()
 endmacro()
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -726,6 +727,114 @@ TEST(IO, bits_eof) {
     }
 }
 
+TEST(IO, bits_bulk) {
+    // integers of random widths, spanning several buffer blocks
+    std::mt19937_64 rnd(1);
+    std::vector<std::pair<uint64_t, size_t>> values;
+    for(size_t i = 0; i < 20000; i++) {
+        const size_t bits = rnd() % 65;
+        const uint64_t mask = (bits == 64) ? ~uint64_t(0) : ((uint64_t(1) << bits) - 1);
+        values.emplace_back(rnd() & mask, bits);
+    }
+
+    std::ostringstream ss_int, ss_bit;
+    {
+        Output output(ss_int);
+        BitOStream out(output);
+        for(auto& v : values) out.write_int(v.first, v.second);
+    }
+    {
+        // reference: write every bit separately
+        Output output(ss_bit);
+        BitOStream out(output);
+        for(auto& v : values) {
+            for(size_t k = v.second; k; k--) out.write_bit((v.first >> (k - 1)) & 1);
+        }
+    }
+    ASSERT_EQ(ss_bit.str(), ss_int.str());
+
+    std::string result = ss_int.str();
+    Input input(result);
+    BitIStream in(input);
+    for(auto& v : values) ASSERT_EQ(v.first, in.read_int<uint64_t>(v.second));
+    ASSERT_TRUE(in.eof());
+}
+
+TEST(IO, bytes_bulk) {
+    // bytes spanning several buffer blocks, at every bit offset
+    std::mt19937_64 rnd(3);
+    std::vector<uint8_t> bytes(10000);
+    for(auto& b : bytes) b = uint8_t(rnd());
+
+    for(size_t offset = 0; offset < 8; offset++) {
+        std::ostringstream ss_bulk, ss_int;
+        {
+            Output output(ss_bulk);
+            BitOStream out(output);
+            out.write_int(0x55, offset);
+            out.write_bytes(bytes.data(), 3);
+            out.write_bytes(bytes.data() + 3, bytes.size() - 3);
+            out.write_int(0x2A, 7);
+        }
+        {
+            // reference: write every byte separately
+            Output output(ss_int);
+            BitOStream out(output);
+            out.write_int(0x55, offset);
+            for(uint8_t b : bytes) out.write_int(b);
+            out.write_int(0x2A, 7);
+        }
+        ASSERT_EQ(ss_int.str(), ss_bulk.str());
+
+        std::string result = ss_bulk.str();
+        Input input(result);
+        BitIStream in(input);
+        ASSERT_EQ(0x55U & ((1U << offset) - 1), in.read_int<size_t>(offset));
+
+        std::vector<uint8_t> decoded(bytes.size());
+        in.read_bytes(decoded.data(), 5);
+        in.read_bytes(decoded.data() + 5, bytes.size() - 5);
+        ASSERT_EQ(bytes, decoded);
+
+        ASSERT_EQ(0x2AU, in.read_int<size_t>(7));
+        ASSERT_TRUE(in.eof());
+    }
+}
+
+TEST(IO, elias_bulk) {
+    // mostly short codes, with some that do not fit into the accumulator
+    std::mt19937_64 rnd(2);
+    std::vector<uint64_t> values;
+    for(size_t i = 0; i < 20000; i++) {
+        const size_t bits = (i % 100 == 0) ? (1 + rnd() % 64) : (1 + rnd() % 12);
+        values.push_back(std::max(uint64_t(1), rnd() >> (64 - bits)));
+    }
+
+    std::ostringstream ss;
+    {
+        Output output(ss);
+        BitOStream out(output);
+        for(auto v : values) out.write_elias_gamma(v);
+        for(auto v : values) out.write_elias_delta(v);
+        out.write_elias_gamma(7);
+    }
+
+    std::string result = ss.str();
+    Input input(result);
+    BitIStream in(input);
+
+    std::vector<uint64_t> decoded(values.size());
+    in.read_elias_gamma(decoded.data(), 7);
+    in.read_elias_gamma(decoded.data() + 7, values.size() - 7);
+    ASSERT_EQ(values, decoded);
+
+    in.read_elias_delta(decoded.data(), values.size());
+    ASSERT_EQ(values, decoded);
+
+    ASSERT_EQ(7U, in.read_elias_gamma<uint64_t>());
+    ASSERT_TRUE(in.eof());
+}
+
 TEST(View, construction) {
     static const uint8_t DATA[3] = { 'f', 'o', 'o' };
 
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include <tudocomp/util/vbyte.hpp>
+#include <tudocomp/util/streamvbyte.hpp>
 
 #include "test/util.hpp"
 
@@ -33,3 +36,35 @@ TEST(VByte, heavy) {
 	}
 
 }
+
+TEST(StreamVByte, roundtrip) {
+	std::mt19937_64 rnd(3);
+	for(size_t n : { 0, 1, 3, 4, 5, 17, 1000, 100003 }) {
+		std::vector<uint32_t> values(n);
+		for(auto& v : values) v = uint32_t(rnd()) >> (rnd() % 32);
+
+		std::vector<uint8_t> bytes(stream_vbyte_max_bytes(n));
+		const size_t size = encode_stream_vbyte(values.data(), n, bytes.data());
+		ASSERT_LE(size, bytes.size());
+		bytes.resize(size); // no slack after the data bytes
+
+		std::vector<uint32_t> decoded(n);
+		ASSERT_EQ(size, decode_stream_vbyte(bytes.data(), size, decoded.data(), n));
+		ASSERT_EQ(values, decoded);
+	}
+}
+
+TEST(StreamVByte, lengths) {
+	const std::vector<uint32_t> values = { 0, 255, 256, 65535, 65536, (1U << 24) - 1, 1U << 24, 0xFFFFFFFFU };
+	std::vector<uint8_t> bytes(stream_vbyte_max_bytes(values.size()));
+	const size_t size = encode_stream_vbyte(values.data(), values.size(), bytes.data());
+
+	// two control bytes and 1+1+2+2+3+3+4+4 data bytes
+	ASSERT_EQ(2U + 20U, size);
+	ASSERT_EQ(0x50, bytes[0]);
+	ASSERT_EQ(0xFA, bytes[1]);
+
+	std::vector<uint32_t> decoded(values.size());
+	decode_stream_vbyte(bytes.data(), size, decoded.data(), values.size());
+	ASSERT_EQ(values, decoded);
+}